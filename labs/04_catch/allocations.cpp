@@ -0,0 +1,47 @@
+#include "catch.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace std;
+
+// Counts every heap allocation made in this program, so that a test can check
+// how many it made itself
+namespace {
+	size_t allocations = 0;
+}
+
+void* operator new(size_t size) {
+	++allocations;
+	if (void* p = malloc(size ? size : 1))
+		return p;
+	throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+TEST_CASE("passing assertions make no heap allocations", "[catch][allocations]") {
+	if (Catch::getResultCapture().reportsPassingAssertions()) {
+		WARN("Passing assertions are reported, so they allocate; run without -s to check");
+		return;
+	}
+
+	int a = 1, b = 1;
+	string text = "a string long enough to be on the heap";
+	size_t before = 0;
+	for (int i = 0; i < 1001; i++) {
+		// The first time round grows the reused buffers to size
+		if (i == 1)
+			before = allocations;
+		CHECK(a == b);
+		REQUIRE(a == b);
+		CHECK(text == text);
+		CHECK_FALSE(a != b);
+		REQUIRE_NOTHROW((void)a);
+	}
+	auto made = allocations - before;
+
+	REQUIRE(made == 0);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.h"
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using Catch::Text;
+using Catch::TextAttributes;
+
+// Tbc::Text and TestSpec are only compiled into the file that implements
+// Catch, so their tests are here rather than in files of their own
+
+TEST_CASE("Text lines can be read by reference", "[catch][text]") {
+	static_assert(is_same<decltype(declval<Text const&>()[0]), string const&>::value, "operator[] returns a reference");
+
+	Text text("a sentence long enough to wrap twice at twenty", TextAttributes().setWidth(20).setIndent(2));
+	vector<string> lines(text.begin(), text.end());
+	string const& first = text[0];
+
+	REQUIRE(lines == (vector<string>{ "  a sentence long", "  enough to wrap", "  twice at twenty" }));
+	REQUIRE(text.size() == 3);
+	REQUIRE(&first == &*text.begin());
+	REQUIRE(&text.last() == &text[2]);
+	REQUIRE(text.toString() == lines[0] + "\n" + lines[1] + "\n" + lines[2]);
+}
+
+TEST_CASE("Text lines include the hyphen and the truncation message", "[catch][text]") {
+	Text hyphenated("unbreakablewordthatislong", TextAttributes().setWidth(10));
+	REQUIRE(hyphenated[0] == "unbreakab-");
+
+	Text truncated(string(2000, '\n'));
+	REQUIRE(truncated.size() == 1001);
+	REQUIRE(truncated.last() == "... message truncated due to excessive size");
+	REQUIRE(distance(truncated.begin(), truncated.end()) == 1001);
+}
+
+// Lays out names and tags as --list-tests does, which is where Text spends
+// most of its time when a suite has thousands of tests
+TEST_CASE("laying out test names for --list-tests", "[catch][text][benchmark]") {
+	vector<string> names;
+	for (int i = 0; i < 1000; ++i)
+		names.push_back("Scenario: a reasonably long test name that wraps once it is indented, number " + to_string(i));
+	TextAttributes nameAttr;
+	nameAttr.setInitialIndent(2).setIndent(4);
+	TextAttributes tagsAttr;
+	tagsAttr.setIndent(6);
+
+	ostringstream oss;
+	BENCHMARK("1000 names and tags") {
+		oss.str(string());
+		for (size_t i = 0; i < names.size(); ++i)
+			oss << Text(names[i], nameAttr) << '\n' << Text("[catch][text][benchmark]", tagsAttr) << '\n';
+	}
+	REQUIRE(oss.str().size() > names.size() * names[0].size());
+}
+
+TEST_CASE("TestSpec patterns match as the spec lowered from them does", "[catch][testspec]") {
+	using Catch::TestSpec;
+	Catch::TestCaseInfo slow("Alpha beta", "", "", set<string>{ "a", "Slow" }, CATCH_INTERNAL_LINEINFO);
+	Catch::TestCaseInfo fast("alpha gamma", "", "", set<string>{ "a" }, CATCH_INTERNAL_LINEINFO);
+
+	Catch::Ptr<TestSpec::Pattern> name = new TestSpec::NamePattern("alpha*");
+	Catch::Ptr<TestSpec::Pattern> tag = new TestSpec::TagPattern("slow");
+	Catch::Ptr<TestSpec::Pattern> notSlow = new TestSpec::ExcludedPattern(tag);
+	TestSpec spec = Catch::parseTestSpec("~[slow]alpha*");
+
+	REQUIRE(name->matches(slow));
+	REQUIRE(name->matches(fast));
+	REQUIRE(tag->matches(slow));
+	REQUIRE_FALSE(notSlow->matches(slow));
+	REQUIRE(notSlow->matches(fast));
+	REQUIRE_FALSE(spec.matches(slow));
+	REQUIRE(spec.matches(fast));
+	REQUIRE(Catch::parseTestSpec("ALPHA BETA").matches(slow));
+}
\ No newline at end of file
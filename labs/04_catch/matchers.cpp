@@ -0,0 +1,95 @@
+#include "catch.h"
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Catch::Matchers;
+
+// A failing CHECK_THAT that doesn't fail the test, so the test can look at
+// what the failure did
+#define CHECK_THAT_NOFAIL(arg, matcher) INTERNAL_CHECK_THAT(arg, matcher, Catch::ResultDisposition::ContinueOnFailure | Catch::ResultDisposition::SuppressFail, "CHECK_THAT_NOFAIL")
+
+TEST_CASE("CHECK_THAT evaluates its argument and matcher once", "[catch][matchers]") {
+	int args = 0;
+	int matchers = 0;
+	auto arg = [&] { ++args; return string("actual"); };
+	auto matcher = [&] { ++matchers; return Equals("expected"); };
+
+	CHECK_THAT_NOFAIL(arg(), matcher());
+
+	REQUIRE(args == 1);
+	REQUIRE(matchers == 1);
+}
+
+TEST_CASE("ApproxEquals treats non-finite values as Approx does", "[catch][matchers]") {
+	double const inf = numeric_limits<double>::infinity();
+	double const nan = numeric_limits<double>::quiet_NaN();
+	vector<double> infs(300, inf);
+	vector<double> nans(300, nan);
+	vector<float> float_infs(300, numeric_limits<float>::infinity());
+
+	REQUIRE_FALSE(inf == Approx(inf));
+	REQUIRE_FALSE(ApproxEquals(infs).match(infs));
+	REQUIRE_FALSE(ApproxEquals(float_infs).match(float_infs));
+	REQUIRE_FALSE(nan == Approx(nan));
+	REQUIRE_FALSE(ApproxEquals(nans).match(nans));
+}
+
+TEST_CASE("ApproxEquals reports the mismatching elements only", "[catch][matchers]") {
+	vector<double> expected(1000, 1.0);
+	vector<double> actual(expected);
+	actual[12] = 1.5;
+	actual[700] = 3.0;
+
+	auto matcher = ApproxEquals(expected);
+
+	REQUIRE(matcher.describeValue(actual) == "{ 1000 elements }");
+	REQUIRE(matcher.describeMismatch(actual) ==
+		"2 of 1000 elements differ, worst error 2.0 at index 700\n"
+		"  [12] 1.5 against 1.0\n"
+		"  [700] 3.0 against 1.0");
+	REQUIRE(matcher.describeMismatch(expected).empty());
+}
+
+TEST_CASE("ApproxEquals lists the first few mismatching elements", "[catch][matchers]") {
+	vector<double> expected(10, 1.0);
+	vector<double> actual(10, 2.0);
+
+	string mismatch = ApproxEquals(expected).describeMismatch(actual);
+
+	REQUIRE_THAT(mismatch, StartsWith("10 of 10 elements differ"));
+	REQUIRE_THAT(mismatch, Contains("[4] 2.0 against 1.0"));
+	REQUIRE_THAT(mismatch, !Contains("[5]") && EndsWith("..."));
+}
+
+TEST_CASE("a failing && reports the mismatch of the side that failed", "[catch][matchers]") {
+	vector<double> expected(4, 1.0);
+	vector<double> actual{ 1.0, 1.0, 1.0, 2.0 };
+	auto matcher = ApproxEquals(expected) && ApproxEquals(expected).epsilon(0.5);
+
+	REQUIRE(matcher.describeMismatch(actual) ==
+		"1 of 4 elements differ, worst error 1.0 at index 3\n"
+		"  [3] 2.0 against 1.0");
+	REQUIRE(matcher.describeValue(actual) == "{ 4 elements }");
+}
+
+TEST_CASE("a failing || reports every alternative", "[catch][matchers]") {
+	vector<double> expected(4, 1.0);
+	vector<double> actual{ 1.0, 1.0, 1.0, 2.0 };
+	auto matcher = Equals("x") || StartsWith("y") || !Contains("b");
+
+	REQUIRE(matcher.describeMismatch("abc") ==
+		"none matched:\n"
+		"  equals: \"x\"\n"
+		"  starts with: \"y\"\n"
+		"  not contains: \"b\": matched: contains: \"b\"");
+	REQUIRE_THAT(
+		(ApproxEquals(expected) || ApproxEquals(expected).scale(0.0)).describeMismatch(actual),
+		StartsWith("none matched:\n  approx equals: 4 elements (epsilon") && Contains("[3] 2.0 against 1.0"));
+}
+
+TEST_CASE("a failing ! reports what matched", "[catch][matchers]") {
+	REQUIRE((!Contains("b")).describeMismatch("abc") == "matched: contains: \"b\"");
+	REQUIRE((!(Equals("x") || Contains("b"))).describeMismatch("abc") == "matched: ( equals: \"x\" or contains: \"b\" )");
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "catch.h"
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// INFO and CAPTURE hold their values unformatted until a failure is reported,
+// so these read back what the builder would have shown at that point
+string reported(Catch::MessageBuilder const& builder) {
+	if (builder.isFormatted())
+		return builder.str();
+	auto args = builder.args();
+	auto& arena = Catch::getResultCapture().messageArena();
+	ostringstream oss;
+	arena.writeTo(oss, args.begin, args.end);
+	arena.truncate(args.begin);
+	return oss.str();
+}
+
+#define MESSAGE_BUILDER Catch::MessageBuilder("INFO", CATCH_INTERNAL_LINEINFO, Catch::ResultWas::Info)
+
+struct Name {
+	char text[8];
+};
+
+Name make_name() {
+	return Name{ "rvalue" };
+}
+
+TEST_CASE("messages keep fundamental values unformatted", "[catch][messages]") {
+	auto builder = MESSAGE_BUILDER;
+	builder << "x = " << 42 << ", y = " << 1.5 << ", " << true << ' ' << 'c';
+
+	REQUIRE_FALSE(builder.isFormatted());
+	REQUIRE(reported(builder) == "x = 42, y = 1.5, 1 c");
+}
+
+TEST_CASE("messages copy char arrays that go out of scope", "[catch][messages]") {
+	auto builder = MESSAGE_BUILDER;
+	{
+		char const const_array[] = "const";
+		char array[] = "mutable";
+		builder << const_array << ' ' << array << ' ';
+	}
+	builder << make_name().text;
+
+	REQUIRE(reported(builder) == "const mutable rvalue");
+}
+
+TEST_CASE("messages write null strings as toString does", "[catch][messages]") {
+	char const* null_string = nullptr;
+	auto builder = MESSAGE_BUILDER;
+	builder << null_string;
+
+	REQUIRE(reported(builder) == Catch::toString(null_string));
+}
+
+TEST_CASE("messages are formatted once a manipulator is streamed", "[catch][messages]") {
+	auto builder = MESSAGE_BUILDER;
+	builder << "hex " << hex << 255;
+
+	REQUIRE(builder.isFormatted());
+	REQUIRE(reported(builder) == "hex ff");
+}
+
+TEST_CASE("INFO with a null string reports the failure", "[catch][messages][!shouldfail]") {
+	char const* null_string = nullptr;
+	INFO(null_string);
+	CHECK(1 == 2);
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "catch.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Each run of a test case enters one SECTION and passes over all the others,
+// so n sibling sections make n runs that meet n sections each. What has to
+// stay flat is the cost of meeting one: finding its tracker among n others
+namespace {
+	int const sectionCount = 10000;
+
+	vector<string> const& sectionNames() {
+		static vector<string> names;
+		if (names.empty())
+			for (int i = 0; i < sectionCount; ++i)
+				names.push_back("section " + to_string(i)); // Short enough to need no allocation
+		return names;
+	}
+
+	vector<int> entered(sectionCount);
+	long long met = 0;
+	chrono::steady_clock::time_point started;
+}
+
+TEST_CASE("10000 sibling sections are each entered once", "[catch][sections]") {
+	vector<string> const& names = sectionNames();
+	if (met == 0)
+		started = chrono::steady_clock::now();
+
+	for (int i = 0; i < sectionCount; ++i) {
+		++met;
+		SECTION(names[i]) {
+			++entered[i];
+		}
+	}
+
+	if (entered.back() == 1) {
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+		WARN(met << " sections met in " << seconds << "s, " << seconds * 1e9 / met << "ns each");
+		REQUIRE(met == static_cast<long long>(sectionCount) * sectionCount);
+		for (int i = 0; i < sectionCount; ++i)
+			REQUIRE(entered[i] == 1);
+	}
+}
\ No newline at end of file
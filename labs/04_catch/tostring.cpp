@@ -0,0 +1,107 @@
+#include "catch.h"
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// How toString formatted floating point values when it built a stream for
+// each: fixed notation, then trailing zeros trimmed to one after the point
+template<typename T>
+string streamed(T value, int precision) {
+	ostringstream oss;
+	oss << setprecision(precision) << fixed << value;
+	string d = oss.str();
+	size_t i = d.find_last_not_of('0');
+	if (i != string::npos && i != d.size() - 1) {
+		if (d[i] == '.')
+			i++;
+		d = d.substr(0, i + 1);
+	}
+	return d;
+}
+
+TEST_CASE("toString writes doubles as it did through a stream", "[catch][tostring]") {
+	double const values[] = {
+		0.0, -0.0, 1.0, -1.0, 0.5, 0.1, 0.2 + 0.1, 1.0 / 3, 2.0 / 3, -2.0 / 3,
+		1e-10, 4e-11, 6e-11, 1e-300, 0.00000000005, 123456789.125, 9007199254740993.0,
+		1e15, 1e20, 1e300, -1e300, numeric_limits<double>::max(), numeric_limits<double>::min(),
+		numeric_limits<double>::denorm_min(), numeric_limits<double>::epsilon(), numeric_limits<double>::infinity()
+	};
+	for (double value : values) {
+		INFO(streamed(value, 10));
+		REQUIRE(Catch::toString(value) == streamed(value, 10));
+	}
+
+	REQUIRE(Catch::toString(1.0) == "1.0");
+	REQUIRE(Catch::toString(-0.0) == "-0.0");
+	REQUIRE(Catch::toString(2.0 / 3) == "0.6666666667");
+	REQUIRE(Catch::toString(4e-11) == "0.0");
+	REQUIRE(Catch::toString(6e-11) == "0.0000000001");
+	REQUIRE(Catch::toString(1e20) == "100000000000000000000.0");
+}
+
+TEST_CASE("toString writes floats as it did through a stream", "[catch][tostring]") {
+	float const values[] = {
+		0.0f, -0.0f, 1.0f, 0.1f, 1.1f, 3.14159265f, 1.0f / 3, 2.0f / 3, 0.000004f, 0.000006f,
+		16777217.0f, 1e30f, numeric_limits<float>::max(), numeric_limits<float>::min(), numeric_limits<float>::infinity()
+	};
+	for (float value : values) {
+		INFO(streamed(value, 5));
+		REQUIRE(Catch::toString(value) == streamed(value, 5) + "f");
+	}
+
+	REQUIRE(Catch::toString(1.1f) == "1.1f");
+	REQUIRE(Catch::toString(3.14159265f) == "3.14159f");
+	REQUIRE(Catch::toString(0.000006f) == "0.00001f");
+}
+
+// Values with no more decimal places than toString writes parse back to
+// themselves: every multiple of 2^-10 has at most 10, and of 2^-5 at most 5
+TEST_CASE("toString of a double parses back to the same value", "[catch][tostring]") {
+	for (int i = -200000; i <= 200000; ++i) {
+		double value = i / 1024.0;
+		string written = Catch::toString(value);
+		if (strtod(written.c_str(), nullptr) != value)
+			FAIL(written << " was written for " << setprecision(17) << value);
+	}
+	double const large[] = { 1e15, -4503599627370497.0, 1e22, ldexp(1.0, 80) };
+	for (double value : large)
+		REQUIRE(strtod(Catch::toString(value).c_str(), nullptr) == value);
+}
+
+TEST_CASE("toString of a float parses back to the same value", "[catch][tostring]") {
+	for (int i = -200000; i <= 200000; ++i) {
+		float value = i / 32.0f;
+		string written = Catch::toString(value);
+		if (written.back() != 'f' || strtof(written.c_str(), nullptr) != value)
+			FAIL(written << " was written for " << setprecision(9) << value);
+	}
+}
+
+// snprintf follows the C locale, which a program may set to one with a
+// decimal comma, where the stream always wrote a point
+TEST_CASE("toString writes a decimal point whatever the C locale", "[catch][tostring]") {
+	char const* const commaLocales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "German", "de-DE" };
+	string const previous = setlocale(LC_NUMERIC, nullptr);
+	char const* set = nullptr;
+	for (char const* name : commaLocales)
+		if ((set = setlocale(LC_NUMERIC, name)) != nullptr)
+			break;
+	if (!set) {
+		WARN("No locale with a decimal comma is installed");
+		return;
+	}
+	string const decimal = localeconv()->decimal_point;
+	string const written = Catch::toString(1.5);
+	string const writtenFloat = Catch::toString(0.25f);
+	setlocale(LC_NUMERIC, previous.c_str());
+
+	REQUIRE(decimal == ",");
+	REQUIRE(written == "1.5");
+	REQUIRE(writtenFloat == "0.25f");
+}
\ No newline at end of file
@@ -74,6 +74,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <vector>
 
 // #included from: catch_compiler_capabilities.h
 #define TWOBLUECUBES_CATCH_COMPILER_CAPABILITIES_HPP_INCLUDED
@@ -94,6 +95,10 @@
 
 // CATCH_CONFIG_VARIADIC_MACROS : are variadic macros supported?
 // CATCH_CONFIG_COUNTER : is the __COUNTER__ macro supported?
+// CATCH_CONFIG_FORK : can test cases be run in forked worker processes (--jobs)?
+// CATCH_CONFIG_FD_CAPTURE : can stdout and stderr be captured at the file descriptor level (--capture-fd)?
+// CATCH_CONFIG_SSE2 : can SSE2 intrinsics be used (ApproxEquals)?
+// CATCH_CONFIG_CPP11_THREADS : are std::thread, std::mutex and std::condition_variable supported (--async-reporter)?
 // ****************
 // Note to maintainers: if new toggles are added please document them
 // in configuration.md, too
@@ -178,6 +183,10 @@
 #   define CATCH_INTERNAL_CONFIG_CPP11_UNIQUE_PTR
 #endif
 
+#if (_MSC_VER >= 1700 ) // (VC++ 11 (VS2012))
+#define CATCH_INTERNAL_CONFIG_CPP11_THREADS
+#endif
+
 #if (_MSC_VER >= 1900 ) // (VC++ 13 (VS2015))
 #define CATCH_INTERNAL_CONFIG_CPP11_NOEXCEPT
 #define CATCH_INTERNAL_CONFIG_CPP11_GENERATED_METHODS
@@ -246,6 +255,9 @@
 #  if !defined(CATCH_INTERNAL_CONFIG_CPP11_UNIQUE_PTR)
 #    define CATCH_INTERNAL_CONFIG_CPP11_UNIQUE_PTR
 #  endif
+#  if !defined(CATCH_INTERNAL_CONFIG_CPP11_THREADS)
+#    define CATCH_INTERNAL_CONFIG_CPP11_THREADS
+#  endif
 
 #endif // __cplusplus >= 201103L
 
@@ -277,6 +289,9 @@
 #if defined(CATCH_INTERNAL_CONFIG_CPP11_UNIQUE_PTR) && !defined(CATCH_CONFIG_NO_UNIQUE_PTR) && !defined(CATCH_CONFIG_CPP11_UNIQUE_PTR) && !defined(CATCH_CONFIG_NO_CPP11)
 #   define CATCH_CONFIG_CPP11_UNIQUE_PTR
 #endif
+#if defined(CATCH_INTERNAL_CONFIG_CPP11_THREADS) && !defined(CATCH_CONFIG_CPP11_NO_THREADS) && !defined(CATCH_CONFIG_CPP11_THREADS) && !defined(CATCH_CONFIG_NO_CPP11)
+#   define CATCH_CONFIG_CPP11_THREADS
+#endif
 #if defined(CATCH_INTERNAL_CONFIG_COUNTER) && !defined(CATCH_CONFIG_NO_COUNTER) && !defined(CATCH_CONFIG_COUNTER)
 #   define CATCH_CONFIG_COUNTER
 #endif
@@ -374,6 +389,13 @@ namespace Catch {
     std::string trim( std::string const& str );
     bool replaceInPlace( std::string& str, std::string const& replaceThis, std::string const& withThis );
 
+    // For the tab separated lines of the files Catch keeps between runs:
+    // escapes backslashes, tabs and newlines within a field, and splits a
+    // line into its (still escaped) fields
+    std::string escapeLineField( std::string const& field );
+    std::string unescapeLineField( std::string const& field );
+    std::vector<std::string> splitLineFields( std::string const& line );
+
     struct pluralise {
         pluralise( std::size_t count, std::string const& label );
 
@@ -397,7 +419,12 @@ namespace Catch {
         bool operator == ( SourceLineInfo const& other ) const;
         bool operator < ( SourceLineInfo const& other ) const;
 
-        std::string file;
+        // Points at the (static) file name rather than copying it, so
+        // locations cost nothing to build at every assertion.
+        // NB: this used to be a std::string. Reporters and listeners that
+        // used it as one (c_str(), size(), +) no longer compile, and need to
+        // build a std::string from it first
+        char const* file;
         std::size_t line;
     };
 
@@ -628,12 +655,13 @@ namespace Catch {
     struct ITestCaseRegistry {
         virtual ~ITestCaseRegistry();
         virtual std::vector<TestCase> const& getAllTests() const = 0;
-        virtual std::vector<TestCase> const& getAllTestsSorted( IConfig const& config ) const = 0;
+        // Points into getAllTests(), so that nothing is copied to reorder them
+        virtual std::vector<TestCase const*> const& getAllTestsSorted( IConfig const& config ) const = 0;
     };
 
     bool matchTest( TestCase const& testCase, TestSpec const& testSpec, IConfig const& config );
-    std::vector<TestCase> filterTests( std::vector<TestCase> const& testCases, TestSpec const& testSpec, IConfig const& config );
-    std::vector<TestCase> const& getAllTestCasesSorted( IConfig const& config );
+    std::vector<TestCase const*> filterTests( std::vector<TestCase const*> const& testCases, TestSpec const& testSpec, IConfig const& config );
+    std::vector<TestCase const*> const& getAllTestCasesSorted( IConfig const& config );
 
 }
 
@@ -881,6 +909,8 @@ namespace Catch {
         std::string getTestMacroName() const;
 
     protected:
+        friend class EventWriter;
+
         AssertionInfo m_info;
         AssertionResultData m_resultData;
     };
@@ -898,6 +928,9 @@ namespace Matchers {
         template<typename ExpressionT> class AllOf;
         template<typename ExpressionT> class AnyOf;
         template<typename ExpressionT> class Not;
+        template<typename LhsT, typename RhsT> class AllOfPair;
+        template<typename LhsT, typename RhsT> class AnyOfPair;
+        template<typename MatcherT> class NotOf;
     }
 
     template<typename ExpressionT>
@@ -910,6 +943,14 @@ namespace Matchers {
         virtual bool match( ExpressionT const& expr ) const = 0;
         virtual std::string toString() const = 0;
 
+        // Explains why expr does not match, for matchers that can say more
+        // than toString() does. Nothing is added to the failure by default
+        virtual std::string describeMismatch( ExpressionT const& ) const { return std::string(); }
+
+        // How expr is written in an assertion, for matchers that would rather
+        // not have it written in full. Empty for the default, toString( expr )
+        virtual std::string describeValue( ExpressionT const& ) const { return std::string(); }
+
         Generic::AllOf<ExpressionT> operator && ( Matcher<ExpressionT> const& other ) const;
         Generic::AnyOf<ExpressionT> operator || ( Matcher<ExpressionT> const& other ) const;
         Generic::Not<ExpressionT> operator ! () const;
@@ -921,6 +962,19 @@ namespace Matchers {
         virtual Ptr<Matcher<ExpressionT> > clone() const {
             return Ptr<Matcher<ExpressionT> >( new DerivedT( static_cast<DerivedT const&>( *this ) ) );
         }
+
+        // When both sides have a known type they are combined by value, so
+        // matching goes straight to the matchers inside without a clone() on
+        // the heap or a virtual call. A side only known as a Matcher falls
+        // back to the combinators on Matcher
+        using Matcher<ExpressionT>::operator &&;
+        using Matcher<ExpressionT>::operator ||;
+
+        template<typename OtherT>
+        Generic::AllOfPair<DerivedT, OtherT> operator && ( MatcherImpl<OtherT, ExpressionT> const& other ) const;
+        template<typename OtherT>
+        Generic::AnyOfPair<DerivedT, OtherT> operator || ( MatcherImpl<OtherT, ExpressionT> const& other ) const;
+        Generic::NotOf<DerivedT> operator ! () const;
     };
 
     namespace Generic {
@@ -1021,6 +1075,118 @@ namespace Matchers {
             std::vector<Ptr<Matcher<ExpressionT> > > m_matchers;
         };
 
+        // A chain like a && b && c nests to the left, and is written out as
+        // one list, as AllOf writes it
+        template<typename MatcherT>
+        std::string allOfTerms( MatcherT const& matcher ) {
+            return matcher.toString();
+        }
+        template<typename LhsT, typename RhsT>
+        std::string allOfTerms( AllOfPair<LhsT, RhsT> const& matcher ) {
+            return allOfTerms( matcher.m_lhs ) + " and " + matcher.m_rhs.toString();
+        }
+        template<typename MatcherT>
+        std::string anyOfTerms( MatcherT const& matcher ) {
+            return matcher.toString();
+        }
+        template<typename LhsT, typename RhsT>
+        std::string anyOfTerms( AnyOfPair<LhsT, RhsT> const& matcher ) {
+            return anyOfTerms( matcher.m_lhs ) + " or " + matcher.m_rhs.toString();
+        }
+
+        // The alternatives of a chain like a || b || c, one to a line, each
+        // with what it had to say about expr
+        template<typename MatcherT>
+        std::string anyOfMismatches( MatcherT const& matcher, typename MatcherT::ExpressionType const& expr ) {
+            std::string mismatch = matcher.describeMismatch( expr );
+            return mismatch.empty()
+                ? matcher.toString()
+                : matcher.toString() + ": " + mismatch;
+        }
+        template<typename LhsT, typename RhsT>
+        std::string anyOfMismatches( AnyOfPair<LhsT, RhsT> const& matcher, typename LhsT::ExpressionType const& expr ) {
+            return anyOfMismatches( matcher.m_lhs, expr ) + "\n  " + anyOfMismatches( matcher.m_rhs, expr );
+        }
+
+        template<typename LhsT, typename RhsT>
+        class AllOfPair : public MatcherImpl<AllOfPair<LhsT, RhsT>, typename LhsT::ExpressionType> {
+        public:
+            typedef typename LhsT::ExpressionType ExpressionT;
+
+            AllOfPair( LhsT const& lhs, RhsT const& rhs ) : m_lhs( lhs ), m_rhs( rhs ) {}
+            AllOfPair( AllOfPair const& other ) : m_lhs( other.m_lhs ), m_rhs( other.m_rhs ) {}
+
+            virtual bool match( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return m_lhs.LhsT::match( expr ) && m_rhs.RhsT::match( expr );
+            }
+            virtual std::string toString() const CATCH_OVERRIDE {
+                return "( " + allOfTerms( *this ) + " )";
+            }
+            virtual std::string describeMismatch( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return m_lhs.LhsT::match( expr )
+                    ? m_rhs.describeMismatch( expr )
+                    : m_lhs.describeMismatch( expr );
+            }
+            virtual std::string describeValue( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                std::string value = m_lhs.describeValue( expr );
+                return value.empty() ? m_rhs.describeValue( expr ) : value;
+            }
+
+            LhsT m_lhs;
+            RhsT m_rhs;
+        };
+
+        template<typename LhsT, typename RhsT>
+        class AnyOfPair : public MatcherImpl<AnyOfPair<LhsT, RhsT>, typename LhsT::ExpressionType> {
+        public:
+            typedef typename LhsT::ExpressionType ExpressionT;
+
+            AnyOfPair( LhsT const& lhs, RhsT const& rhs ) : m_lhs( lhs ), m_rhs( rhs ) {}
+            AnyOfPair( AnyOfPair const& other ) : m_lhs( other.m_lhs ), m_rhs( other.m_rhs ) {}
+
+            virtual bool match( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return m_lhs.LhsT::match( expr ) || m_rhs.RhsT::match( expr );
+            }
+            virtual std::string toString() const CATCH_OVERRIDE {
+                return "( " + anyOfTerms( *this ) + " )";
+            }
+            // Every alternative failed, so each is listed
+            virtual std::string describeMismatch( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return "none matched:\n  " + anyOfMismatches( *this, expr );
+            }
+            virtual std::string describeValue( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                std::string value = m_lhs.describeValue( expr );
+                return value.empty() ? m_rhs.describeValue( expr ) : value;
+            }
+
+            LhsT m_lhs;
+            RhsT m_rhs;
+        };
+
+        template<typename MatcherT>
+        class NotOf : public MatcherImpl<NotOf<MatcherT>, typename MatcherT::ExpressionType> {
+        public:
+            typedef typename MatcherT::ExpressionType ExpressionT;
+
+            explicit NotOf( MatcherT const& matcher ) : m_matcher( matcher ) {}
+            NotOf( NotOf const& other ) : m_matcher( other.m_matcher ) {}
+
+            virtual bool match( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return !m_matcher.MatcherT::match( expr );
+            }
+            virtual std::string toString() const CATCH_OVERRIDE {
+                return "not " + m_matcher.toString();
+            }
+            virtual std::string describeMismatch( ExpressionT const& ) const CATCH_OVERRIDE {
+                return "matched: " + m_matcher.toString();
+            }
+            virtual std::string describeValue( ExpressionT const& expr ) const CATCH_OVERRIDE {
+                return m_matcher.describeValue( expr );
+            }
+
+            MatcherT m_matcher;
+        };
+
     } // namespace Generic
 
     template<typename ExpressionT>
@@ -1044,6 +1210,23 @@ namespace Matchers {
         return Generic::Not<ExpressionT>( *this );
     }
 
+    template<typename DerivedT, typename ExpressionT>
+    template<typename OtherT>
+    Generic::AllOfPair<DerivedT, OtherT> MatcherImpl<DerivedT, ExpressionT>::operator && ( MatcherImpl<OtherT, ExpressionT> const& other ) const {
+        return Generic::AllOfPair<DerivedT, OtherT>( static_cast<DerivedT const&>( *this ), static_cast<OtherT const&>( other ) );
+    }
+
+    template<typename DerivedT, typename ExpressionT>
+    template<typename OtherT>
+    Generic::AnyOfPair<DerivedT, OtherT> MatcherImpl<DerivedT, ExpressionT>::operator || ( MatcherImpl<OtherT, ExpressionT> const& other ) const {
+        return Generic::AnyOfPair<DerivedT, OtherT>( static_cast<DerivedT const&>( *this ), static_cast<OtherT const&>( other ) );
+    }
+
+    template<typename DerivedT, typename ExpressionT>
+    Generic::NotOf<DerivedT> MatcherImpl<DerivedT, ExpressionT>::operator ! () const {
+        return Generic::NotOf<DerivedT>( static_cast<DerivedT const&>( *this ) );
+    }
+
     namespace StdString {
 
         inline std::string makeString( std::string const& str ) { return str; }
@@ -1061,6 +1244,10 @@ namespace Matchers {
                     : str;
 
             }
+            // Only a case insensitive match needs a lowered copy of expr
+            bool caseSensitive() const {
+                return m_caseSensitivity == CaseSensitive::Yes;
+            }
             std::string toStringSuffix() const
             {
                 return m_caseSensitivity == CaseSensitive::No
@@ -1080,7 +1267,9 @@ namespace Matchers {
             virtual ~Equals();
 
             virtual bool match( std::string const& expr ) const {
-                return m_data.m_str == m_data.adjustString( expr );;
+                return m_data.caseSensitive()
+                    ? expr == m_data.m_str
+                    : m_data.adjustString( expr ) == m_data.m_str;
             }
             virtual std::string toString() const {
                 return "equals: \"" + m_data.m_str + "\"" + m_data.toStringSuffix();
@@ -1097,7 +1286,9 @@ namespace Matchers {
             virtual ~Contains();
 
             virtual bool match( std::string const& expr ) const {
-                return m_data.adjustString( expr ).find( m_data.m_str ) != std::string::npos;
+                return m_data.caseSensitive()
+                    ? expr.find( m_data.m_str ) != std::string::npos
+                    : m_data.adjustString( expr ).find( m_data.m_str ) != std::string::npos;
             }
             virtual std::string toString() const {
                 return "contains: \"" + m_data.m_str  + "\"" + m_data.toStringSuffix();
@@ -1115,7 +1306,9 @@ namespace Matchers {
             virtual ~StartsWith();
 
             virtual bool match( std::string const& expr ) const {
-                return startsWith( m_data.adjustString( expr ), m_data.m_str );
+                return m_data.caseSensitive()
+                    ? startsWith( expr, m_data.m_str )
+                    : startsWith( m_data.adjustString( expr ), m_data.m_str );
             }
             virtual std::string toString() const {
                 return "starts with: \"" + m_data.m_str + "\"" + m_data.toStringSuffix();
@@ -1132,7 +1325,9 @@ namespace Matchers {
             virtual ~EndsWith();
 
             virtual bool match( std::string const& expr ) const {
-                return endsWith( m_data.adjustString( expr ), m_data.m_str );
+                return m_data.caseSensitive()
+                    ? endsWith( expr, m_data.m_str )
+                    : endsWith( m_data.adjustString( expr ), m_data.m_str );
             }
             virtual std::string toString() const {
                 return "ends with: \"" + m_data.m_str + "\"" + m_data.toStringSuffix();
@@ -1212,17 +1407,39 @@ namespace Catch {
 
     struct STATIC_ASSERT_Expression_Too_Complex_Please_Rewrite_As_Binary_Comparison;
 
-    struct CopyableStream {
-        CopyableStream() {}
-        CopyableStream( CopyableStream const& other ) {
-            oss << other.oss.str();
+    // Most assertions never stream a message, so the underlying stringstream,
+    // which is expensive to construct, is only created on first use
+    class CopyableStream {
+    public:
+        CopyableStream() : m_oss( CATCH_NULL ) {}
+        CopyableStream( CopyableStream const& other ) : m_oss( CATCH_NULL ) {
+            if( other.m_oss )
+                stream() << other.str();
         }
         CopyableStream& operator=( CopyableStream const& other ) {
-            oss.str("");
-            oss << other.oss.str();
+            if( this != &other ) {
+                delete m_oss;
+                m_oss = CATCH_NULL;
+                if( other.m_oss )
+                    stream() << other.str();
+            }
             return *this;
         }
-        std::ostringstream oss;
+        ~CopyableStream() {
+            delete m_oss;
+        }
+
+        std::ostream& stream() {
+            if( !m_oss )
+                m_oss = new std::ostringstream;
+            return *m_oss;
+        }
+        std::string str() const {
+            return m_oss ? m_oss->str() : std::string();
+        }
+
+    private:
+        std::ostringstream* m_oss;
     };
 
     class ResultBuilder {
@@ -1239,7 +1456,7 @@ namespace Catch {
 
         template<typename T>
         ResultBuilder& operator << ( T const& value ) {
-            m_stream.oss << value;
+            m_stream.stream() << value;
             return *this;
         }
 
@@ -1253,6 +1470,7 @@ namespace Catch {
         ResultBuilder& setOp( std::string const& op );
 
         void endExpression();
+        bool shouldExpand() const;
 
         std::string reconstructExpression() const;
         AssertionResult build() const;
@@ -1262,13 +1480,23 @@ namespace Catch {
         void captureExpression();
         void captureExpectedException( std::string const& expectedMessage );
         void captureExpectedException( Matchers::Impl::Matcher<std::string> const& matcher );
+        template<typename ArgT, typename MatcherT>
+        void captureMatch( ArgT const& arg, MatcherT const& matcher, char const* matcherString );
         void handleResult( AssertionResult const& result );
         void react();
         bool shouldDebugBreak() const;
         bool allowThrows() const;
 
     private:
-        AssertionInfo m_assertionInfo;
+        AssertionInfo assertionInfo() const;
+
+        // The assertion's details are kept as they were passed in, and only
+        // turned into an AssertionInfo when a result has to be built
+        char const* m_macroName;
+        SourceLineInfo m_lineInfo;
+        char const* m_capturedExpression;
+        char const* m_secondArg;
+        ResultDisposition::Flags m_resultDisposition;
         AssertionResultData m_data;
         struct ExprComponents {
             ExprComponents() : testFalse( false ) {}
@@ -1702,6 +1930,11 @@ struct StringMaker<R C::*> {
 namespace Detail {
     template<typename InputIterator>
     std::string rangeToString( InputIterator first, InputIterator last );
+
+    // How many elements of a container are written out, and how many either
+    // side of the first difference between two large ones (0 for no limit)
+    std::size_t containerLimit();
+    std::size_t diffContext();
 }
 
 //template<typename T, typename Allocator>
@@ -1780,16 +2013,102 @@ std::string toString( T const& value ) {
     namespace Detail {
     template<typename InputIterator>
     std::string rangeToString( InputIterator first, InputIterator last ) {
+        std::size_t limit = containerLimit();
+        std::size_t count = 0;
         std::ostringstream oss;
         oss << "{ ";
-        if( first != last ) {
+        for( ; first != last && ( limit == 0 || count < limit ); ++first, ++count ) {
+            if( count > 0 )
+                oss << ", ";
             oss << Catch::toString( *first );
-            for( ++first ; first != last ; ++first )
-                oss << ", " << Catch::toString( *first );
+        }
+        if( first != last ) {
+            // The rest is only counted, so a huge container is cheap to describe
+            for( ; first != last; ++first )
+                ++count;
+            oss << ", ... } (" << count << " elements)";
+            return oss.str();
         }
         oss << " }";
         return oss.str();
     }
+
+    template<typename T, typename Allocator>
+    std::string vectorWindowToString( std::vector<T,Allocator> const& v, std::size_t begin, std::size_t end ) {
+        end = (std::min)( end, v.size() );
+        bool separate = begin > 0;
+        std::ostringstream oss;
+        oss << ( separate ? "{ ..." : "{ " );
+        for( std::size_t i = begin; i < end; ++i, separate = true )
+            oss << ( separate ? ", " : "" ) << Catch::toString( v[i] );
+        if( end < v.size() )
+            oss << ( separate ? ", ..." : "..." );
+        oss << " } (" << v.size() << " elements)";
+        return oss.str();
+    }
+
+    // By default each side of a comparison is expanded on its own
+    template<Internal::Operator Op, typename LhsT, typename RhsT>
+    void expandOperands( ResultBuilder& rb, LhsT const& lhs, RhsT const& rhs ) {
+        rb.setLhs( Catch::toString( lhs ) )
+            .setRhs( Catch::toString( rhs ) );
+    }
+
+    // Two vectors too large to write out in full are compared in one pass
+    // instead, and only the elements around the first difference are shown.
+    // That needs the elements' ==, so only == and != expand this way
+    template<bool ShowsDifference>
+    struct VectorOperands {
+        template<typename LhsT, typename RhsT>
+        static void expand( ResultBuilder& rb, LhsT const& lhs, RhsT const& rhs ) {
+            rb.setLhs( Catch::toString( lhs ) )
+                .setRhs( Catch::toString( rhs ) );
+        }
+    };
+    template<>
+    struct VectorOperands<true> {
+        template<typename T, typename LhsAllocator, typename RhsAllocator>
+        static void expand( ResultBuilder& rb, std::vector<T,LhsAllocator> const& lhs, std::vector<T,RhsAllocator> const& rhs );
+    };
+
+    template<Internal::Operator Op, typename T, typename LhsAllocator, typename RhsAllocator>
+    void expandOperands( ResultBuilder& rb, std::vector<T,LhsAllocator> const& lhs, std::vector<T,RhsAllocator> const& rhs ) {
+        VectorOperands<Op == Internal::IsEqualTo || Op == Internal::IsNotEqualTo>::expand( rb, lhs, rhs );
+    }
+
+    template<typename T, typename LhsAllocator, typename RhsAllocator>
+    void VectorOperands<true>::expand( ResultBuilder& rb, std::vector<T,LhsAllocator> const& lhs, std::vector<T,RhsAllocator> const& rhs ) {
+        std::size_t limit = containerLimit();
+        if( limit == 0 || ( lhs.size() <= limit && rhs.size() <= limit ) ) {
+            VectorOperands<false>::expand( rb, lhs, rhs );
+            return;
+        }
+
+        std::size_t common = (std::min)( lhs.size(), rhs.size() );
+        std::size_t firstDifference = common;
+        std::size_t differences = (std::max)( lhs.size(), rhs.size() ) - common;
+        for( std::size_t i = 0; i < common; ++i ) {
+            if( !( lhs[i] == rhs[i] ) ) {
+                if( firstDifference == common )
+                    firstDifference = i;
+                ++differences;
+            }
+        }
+
+        std::size_t context = diffContext();
+        std::size_t begin = 0;
+        if( differences == 0 )
+            firstDifference = 0;
+        else if( firstDifference > context )
+            begin = firstDifference - context;
+        std::size_t end = firstDifference + context + 1;
+
+        rb.setLhs( vectorWindowToString( lhs, begin, end ) )
+            .setRhs( vectorWindowToString( rhs, begin, end ) );
+        if( differences > 0 )
+            rb << "first difference at index " << firstDifference << ", "
+                << differences << ( differences == 1 ? " element differs" : " elements differ" );
+    }
 }
 
 } // end namespace Catch
@@ -1852,10 +2171,10 @@ public:
 
     void endExpression() {
         bool value = m_lhs ? true : false;
-        m_rb
-            .setLhs( Catch::toString( value ) )
-            .setResultType( value )
-            .endExpression();
+        m_rb.setResultType( value );
+        if( m_rb.shouldExpand() )
+            m_rb.setLhs( Catch::toString( value ) );
+        m_rb.endExpression();
     }
 
     // Only simple binary expressions are allowed on the LHS.
@@ -1870,11 +2189,12 @@ public:
 private:
     template<Internal::Operator Op, typename RhsT>
     ResultBuilder& captureExpression( RhsT const& rhs ) {
-        return m_rb
-            .setResultType( Internal::compare<Op>( m_lhs, rhs ) )
-            .setLhs( Catch::toString( m_lhs ) )
-            .setRhs( Catch::toString( rhs ) )
-            .setOp( Internal::OperatorTraits<Op>::getName() );
+        m_rb.setResultType( Internal::compare<Op>( m_lhs, rhs ) );
+        if( m_rb.shouldExpand() ) {
+            Detail::expandOperands<Op>( m_rb, m_lhs, rhs );
+            m_rb.setOp( Internal::OperatorTraits<Op>::getName() );
+        }
+        return m_rb;
     }
 
 private:
@@ -1896,12 +2216,34 @@ namespace Catch {
         return ExpressionLhs<bool>( *this, value );
     }
 
+    // For CHECK_THAT: arg and the matcher are each evaluated once, by the
+    // macro, however many times they are used here
+    template<typename ArgT, typename MatcherT>
+    void ResultBuilder::captureMatch( ArgT const& arg, MatcherT const& matcher, char const* matcherString ) {
+        bool matched = matcher.match( arg );
+        setResultType( matched );
+        if( shouldExpand() ) {
+            std::string value = matcher.describeValue( arg );
+            std::string matcherAsString = matcher.toString();
+            setLhs( value.empty() ? Catch::toString( arg ) : value )
+                .setRhs( matcherAsString == Detail::unprintableString ? matcherString : matcherAsString )
+                .setOp( "matches" );
+            // describeMismatch() is only for an arg that did not match
+            std::string mismatch = matched ? std::string() : matcher.describeMismatch( arg );
+            if( !mismatch.empty() )
+                *this << mismatch;
+        }
+        captureExpression();
+    }
+
 } // namespace Catch
 
 // #included from: catch_message.h
 #define TWOBLUECUBES_CATCH_MESSAGE_H_INCLUDED
 
 #include <string>
+#include <vector>
+#include <cstring>
 
 namespace Catch {
 
@@ -1926,21 +2268,99 @@ namespace Catch {
         static unsigned int globalCount;
     };
 
+    // Holds the values streamed into INFO and CAPTURE by the running test,
+    // unformatted, until an assertion is reported while they are in scope.
+    // Messages are pushed and popped with the scopes that own them, so the
+    // arena is used as a stack and keeps its storage from one to the next
+    class MessageArena {
+    public:
+        typedef void (*WriteFunction)( std::ostream& os, char const* data, std::size_t size );
+
+        std::size_t size() const { return m_data.size(); }
+        void append( WriteFunction write, void const* data, std::size_t size );
+        void truncate( std::size_t size );
+        void writeTo( std::ostream& os, std::size_t begin, std::size_t end ) const;
+
+    private:
+        std::vector<char> m_data;
+    };
+
+    // Where in the MessageArena a message's values are held; an empty
+    // span means that the message was formatted when it was built
+    struct MessageArgs {
+        MessageArgs( std::size_t _begin, std::size_t _end )
+        :   begin( _begin ),
+            end( _end )
+        {}
+
+        std::size_t begin;
+        std::size_t end;
+    };
+
     struct MessageBuilder {
         MessageBuilder( std::string const& macroName,
                         SourceLineInfo const& lineInfo,
-                        ResultWas::OfType type )
-        : m_info( macroName, lineInfo, type )
-        {}
+                        ResultWas::OfType type );
 
+        // Fundamental types and strings are copied into the arena as they
+        // are. Anything else, manipulators included, needs the stream the
+        // message will be formatted into, so it formats the message now
         template<typename T>
         MessageBuilder& operator << ( T const& value ) {
-            m_stream << value;
+            stream() << value;
             return *this;
         }
+        template<std::size_t N>
+        MessageBuilder& operator << ( char (&value)[N] ) {
+            return *this << static_cast<char const*>( value );
+        }
+        MessageBuilder& operator << ( char const* value );
+        MessageBuilder& operator << ( std::string const& value );
+
+        MessageBuilder& operator << ( bool value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( char value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( signed char value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( unsigned char value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( short value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( unsigned short value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( int value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( unsigned int value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( long value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( unsigned long value ) { return captureValue( value ); }
+#ifdef CATCH_CONFIG_CPP11_LONG_LONG
+        MessageBuilder& operator << ( long long value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( unsigned long long value ) { return captureValue( value ); }
+#endif
+        MessageBuilder& operator << ( float value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( double value ) { return captureValue( value ); }
+        MessageBuilder& operator << ( long double value ) { return captureValue( value ); }
+
+        bool isFormatted() const { return m_formatted; }
+        MessageArgs args() const;
+        std::string str() const { return m_stream.str(); }
 
         MessageInfo m_info;
-        std::ostringstream m_stream;
+
+    private:
+        template<typename T>
+        static void writeValue( std::ostream& os, char const* data, std::size_t ) {
+            T value;
+            std::memcpy( &value, data, sizeof( T ) );
+            os << value;
+        }
+        static void writeChars( std::ostream& os, char const* data, std::size_t size );
+
+        template<typename T>
+        MessageBuilder& captureValue( T value ) {
+            return capture( &MessageBuilder::writeValue<T>, &value, sizeof( T ) );
+        }
+        MessageBuilder& capture( MessageArena::WriteFunction write, void const* data, std::size_t size );
+        std::ostream& stream();
+
+        MessageArena* m_arena;
+        std::size_t m_begin;
+        bool m_formatted;
+        CopyableStream m_stream;
     };
 
     class ScopedMessage {
@@ -1950,6 +2370,7 @@ namespace Catch {
         ~ScopedMessage();
 
         MessageInfo m_info;
+        MessageArgs m_args;
     };
 
 } // end namespace Catch
@@ -1967,23 +2388,31 @@ namespace Catch {
     struct SectionInfo;
     struct SectionEndInfo;
     struct MessageInfo;
+    struct MessageArgs;
+    class MessageArena;
     class ScopedMessageBuilder;
     struct Counts;
+    struct BenchmarkStats;
 
     struct IResultCapture {
 
         virtual ~IResultCapture();
 
         virtual void assertionEnded( AssertionResult const& result ) = 0;
+        virtual void assertionPassed() = 0;
         virtual bool sectionStarted(    SectionInfo const& sectionInfo,
                                         Counts& assertions ) = 0;
         virtual void sectionEnded( SectionEndInfo const& endInfo ) = 0;
         virtual void sectionEndedEarly( SectionEndInfo const& endInfo ) = 0;
-        virtual void pushScopedMessage( MessageInfo const& message ) = 0;
-        virtual void popScopedMessage( MessageInfo const& message ) = 0;
+        virtual void pushScopedMessage( MessageInfo const& message, MessageArgs const& args ) = 0;
+        virtual void popScopedMessage( MessageInfo const& message, MessageArgs const& args ) = 0;
+        virtual MessageArena& messageArena() = 0;
+
+        virtual void benchmarkEnded( BenchmarkStats const& stats ) = 0;
 
         virtual std::string getCurrentTestName() const = 0;
         virtual const AssertionResult* getLastResult() const = 0;
+        virtual bool reportsPassingAssertions() const = 0;
 
         virtual void handleFatalErrorCondition( std::string const& message ) = 0;
     };
@@ -2005,6 +2434,21 @@ namespace Catch {
 #define CATCH_PLATFORM_WINDOWS
 #endif
 
+// Running tests in worker processes needs fork(), which Windows (and iOS) lack
+#if !defined(CATCH_PLATFORM_WINDOWS) && !defined(CATCH_PLATFORM_IPHONE) && !defined(CATCH_CONFIG_NO_FORK) && !defined(CATCH_CONFIG_FORK)
+#define CATCH_CONFIG_FORK
+#endif
+
+// Capturing the file descriptors needs dup2() and an in-memory file to point them at
+#if defined(__linux__) && !defined(CATCH_CONFIG_NO_FD_CAPTURE) && !defined(CATCH_CONFIG_FD_CAPTURE)
+#define CATCH_CONFIG_FD_CAPTURE
+#endif
+
+// SSE2 is part of every x64 target, and of x86 ones that ask for it
+#if ( defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) ) && !defined(CATCH_CONFIG_NO_SSE2) && !defined(CATCH_CONFIG_SSE2)
+#define CATCH_CONFIG_SSE2
+#endif
+
 #include <string>
 
 namespace Catch{
@@ -2164,13 +2608,7 @@ namespace Catch {
     do { \
         Catch::ResultBuilder __catchResult( macroName, CATCH_INTERNAL_LINEINFO, #arg ", " #matcher, resultDisposition ); \
         try { \
-            std::string matcherAsString = (matcher).toString(); \
-            __catchResult \
-                .setLhs( Catch::toString( arg ) ) \
-                .setRhs( matcherAsString == Catch::Detail::unprintableString ? #matcher : matcherAsString ) \
-                .setOp( "matches" ) \
-                .setResultType( (matcher).match( arg ) ); \
-            __catchResult.captureExpression(); \
+            __catchResult.captureMatch( arg, matcher, #matcher ); \
         } catch( ... ) { \
             __catchResult.useActiveException( resultDisposition | Catch::ResultDisposition::ContinueOnFailure ); \
         } \
@@ -2183,6 +2621,12 @@ namespace Catch {
 // #included from: catch_section_info.h
 #define TWOBLUECUBES_CATCH_SECTION_INFO_H_INCLUDED
 
+#ifdef CATCH_PLATFORM_WINDOWS
+typedef unsigned long long uint64_t;
+#else
+#include <stdint.h>
+#endif
+
 // #included from: catch_totals.hpp
 #define TWOBLUECUBES_CATCH_TOTALS_HPP_INCLUDED
 
@@ -2267,13 +2711,13 @@ namespace Catch {
     };
 
     struct SectionEndInfo {
-        SectionEndInfo( SectionInfo const& _sectionInfo, Counts const& _prevAssertions, double _durationInSeconds )
-        : sectionInfo( _sectionInfo ), prevAssertions( _prevAssertions ), durationInSeconds( _durationInSeconds )
+        SectionEndInfo( SectionInfo const& _sectionInfo, Counts const& _prevAssertions, uint64_t _durationInNanoseconds )
+        : sectionInfo( _sectionInfo ), prevAssertions( _prevAssertions ), durationInNanoseconds( _durationInNanoseconds )
         {}
 
         SectionInfo sectionInfo;
         Counts prevAssertions;
-        double durationInSeconds;
+        uint64_t durationInNanoseconds;
     };
 
 } // end namespace Catch
@@ -2281,26 +2725,35 @@ namespace Catch {
 // #included from: catch_timer.h
 #define TWOBLUECUBES_CATCH_TIMER_H_INCLUDED
 
-#ifdef CATCH_PLATFORM_WINDOWS
-typedef unsigned long long uint64_t;
-#else
-#include <stdint.h>
-#endif
+#include <string>
 
 namespace Catch {
 
+    struct TimerClock { enum Type {
+        Wall,       // Monotonic, elapsed real time
+        ThreadCpu   // CPU time consumed by the calling thread
+    }; };
+
+    // Formats a duration as seconds, keeping every digit down to the nanosecond
+    std::string durationToString( uint64_t nanoseconds );
+
     class Timer {
     public:
-        Timer() : m_ticks( 0 ) {}
+        Timer( TimerClock::Type clock = TimerClock::Wall ) : m_nanoseconds( 0 ), m_clock( clock ) {}
         void start();
-        unsigned int getElapsedMicroseconds() const;
-        unsigned int getElapsedMilliseconds() const;
+        uint64_t getElapsedNanoseconds() const;
+        uint64_t getElapsedMicroseconds() const;
+        uint64_t getElapsedMilliseconds() const;
         double getElapsedSeconds() const;
 
     private:
-        uint64_t m_ticks;
+        uint64_t m_nanoseconds;
+        TimerClock::Type m_clock;
     };
 
+    // Nanoseconds since the Unix epoch, for timestamps rather than timings
+    uint64_t getWallClockNanoseconds();
+
 } // namespace Catch
 
 #include <string>
@@ -2334,6 +2787,167 @@ namespace Catch {
         if( Catch::Section const& INTERNAL_CATCH_UNIQUE_NAME( catch_internal_Section ) = Catch::SectionInfo( CATCH_INTERNAL_LINEINFO, name, desc ) )
 #endif
 
+// #included from: internal/catch_benchmark.h
+#define TWOBLUECUBES_CATCH_BENCHMARK_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace Catch {
+
+    struct BenchmarkInfo {
+        BenchmarkInfo( std::string const& _name, SourceLineInfo const& _lineInfo )
+        :   name( _name ),
+            lineInfo( _lineInfo )
+        {}
+
+        std::string name;
+        SourceLineInfo lineInfo;
+    };
+
+    // Samples classified by Tukey's fences: mild outliers lie more than 1.5
+    // interquartile ranges outside the quartiles, severe ones more than 3
+    struct OutlierClassification {
+        OutlierClassification() : lowSevere( 0 ), lowMild( 0 ), highMild( 0 ), highSevere( 0 ) {}
+
+        std::size_t total() const {
+            return lowSevere + lowMild + highMild + highSevere;
+        }
+
+        std::size_t lowSevere;
+        std::size_t lowMild;
+        std::size_t highMild;
+        std::size_t highSevere;
+    };
+
+    // All times are in nanoseconds per iteration
+    struct BenchmarkStats {
+        BenchmarkStats( BenchmarkInfo const& _info,
+                        uint64_t _iterationsPerSample,
+                        std::vector<double> const& _samples );
+
+        BenchmarkInfo info;
+        uint64_t iterationsPerSample;
+        std::vector<double> samples;
+
+        double mean;
+        double median;
+        double standardDeviation;
+        double min;
+        double max;
+        OutlierClassification outliers;
+    };
+
+    // Linearly interpolated quantile of an already sorted, non-empty range
+    double quantile( std::vector<double> const& sorted, double q );
+
+    // Formats a time in the most readable unit, e.g. "12.345 ns" or "1.500 ms"
+    std::string nanosecondsToString( double nanoseconds );
+
+    // Relative change in the median time of a benchmark against its baseline,
+    // e.g. 0.1 for 10% slower, with a 95% bootstrap confidence interval
+    struct BenchmarkComparison {
+        BenchmarkComparison() : change( 0 ), lowerBound( 0 ), upperBound( 0 ) {}
+
+        double change;
+        double lowerBound;
+        double upperBound;
+    };
+
+    BenchmarkComparison compareBenchmarkSamples( std::vector<double> const& baseline,
+                                                 std::vector<double> const& current,
+                                                 std::size_t resamples = 1000 );
+
+    // The samples of every benchmark run, keyed by test case and benchmark
+    // name, as saved by --benchmark-save and read back by --benchmark-compare
+    class BenchmarkBaseline {
+    public:
+        void add( std::string const& testName, BenchmarkStats const& stats );
+        std::vector<double> const* find( std::string const& testName, std::string const& benchmarkName ) const;
+
+        void load( std::string const& filename );
+        void save( std::string const& filename ) const;
+
+    private:
+        typedef std::map<std::pair<std::string, std::string>, std::vector<double> > Samples;
+        Samples m_samples;
+    };
+
+    // Drives the body of a BENCHMARK: a warmup, which also estimates how long an
+    // iteration takes, then enough iterations per sample that each sample spans
+    // many ticks of the clock, then the samples themselves
+    class BenchmarkLooper {
+    public:
+        BenchmarkLooper( std::string const& name, SourceLineInfo const& lineInfo );
+
+        operator bool() {
+            if( m_remaining > 0 )
+                return true;
+            return nextBatch();
+        }
+        void increment() {
+            --m_remaining;
+        }
+
+    private:
+        bool nextBatch();
+
+        BenchmarkInfo m_info;
+        Timer m_timer;
+        uint64_t m_batchSize;
+        uint64_t m_remaining;
+        bool m_warmingUp;
+
+        uint64_t m_warmupNanoseconds;
+        uint64_t m_warmupElapsed;
+
+        std::size_t m_sampleCount;
+        std::vector<double> m_samples;
+    };
+
+} // end namespace Catch
+
+#define INTERNAL_CATCH_BENCHMARK( name ) \
+    for( Catch::BenchmarkLooper catch_internal_benchmarkLooper( name, CATCH_INTERNAL_LINEINFO ); catch_internal_benchmarkLooper; catch_internal_benchmarkLooper.increment() )
+
+// #included from: internal/catch_test_durations.h
+#define TWOBLUECUBES_CATCH_TEST_DURATIONS_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace Catch {
+
+    class TestCase;
+
+    // How long each test case took in earlier runs, keyed by test name, as
+    // kept in the --durations-file
+    class TestDurations {
+    public:
+        void set( std::string const& testName, uint64_t nanoseconds );
+        void merge( TestDurations const& newer );
+        uint64_t const* find( std::string const& testName ) const;
+        bool empty() const { return m_nanoseconds.empty(); }
+
+        // A file that does not exist yet just has no durations in it
+        bool load( std::string const& filename );
+        void save( std::string const& filename ) const;
+
+    private:
+        std::map<std::string, uint64_t> m_nanoseconds;
+    };
+
+    // Deals test cases out to a number of groups so that each group takes
+    // about as long as the others, and returns the group of each test case.
+    // Test cases without a duration count as average ones
+    std::vector<std::size_t> balanceTests( std::vector<TestCase const*> const& testCases,
+                                           std::size_t groups,
+                                           TestDurations const& durations );
+
+} // end namespace Catch
+
 // #included from: internal/catch_generators.hpp
 #define TWOBLUECUBES_CATCH_GENERATORS_HPP_INCLUDED
 
@@ -2621,7 +3235,13 @@ namespace Catch {
 #define TWOBLUECUBES_CATCH_APPROX_HPP_INCLUDED
 
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <vector>
+
+#ifdef CATCH_CONFIG_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace Catch {
 namespace Detail {
@@ -2696,24 +3316,233 @@ inline std::string toString<Detail::Approx>( Detail::Approx const& value ) {
     return value.toString();
 }
 
-} // end namespace Catch
-
-// #included from: internal/catch_interfaces_tag_alias_registry.h
-#define TWOBLUECUBES_CATCH_INTERFACES_TAG_ALIAS_REGISTRY_H_INCLUDED
+namespace Matchers {
+namespace Impl {
+namespace Floating {
 
-// #included from: catch_tag_alias.h
-#define TWOBLUECUBES_CATCH_TAG_ALIAS_H_INCLUDED
+    template<typename T> struct FloatingBits;
+    template<> struct FloatingBits<float> { typedef unsigned int Type; };
+    template<> struct FloatingBits<double> { typedef uint64_t Type; };
 
-#include <string>
+    // Maps the bits of a float onto an unsigned integer that increases with
+    // the value, so the distance between two of them is a count of ulps
+    template<typename T>
+    typename FloatingBits<T>::Type orderedBits( T value ) {
+        typedef typename FloatingBits<T>::Type Bits;
+        Bits bits;
+        std::memcpy( &bits, &value, sizeof( bits ) );
+        Bits const signBit = Bits( 1 ) << ( sizeof( Bits ) * 8 - 1 );
+        return ( bits & signBit ) ? ~bits : ( bits | signBit );
+    }
+
+    // Whether any element of lhs is outside the epsilon margin of the one at
+    // the same index of rhs. Every element goes through this loop, so it is
+    // branch free and written with SSE2 where the target has it. The test is
+    // Approx's, so the same non-finite values fail: a NaN anywhere, and an
+    // infinity even against the same infinity, as their difference is a NaN
+    template<typename T>
+    bool anyOutsideEpsilon( T const* lhs, T const* rhs, std::size_t n, T epsilon, T scale ) {
+        bool inside = true;
+        for( std::size_t i = 0; i < n; ++i ) {
+            T const margin = epsilon * ( scale + (std::max)( std::fabs( lhs[i] ), std::fabs( rhs[i] ) ) );
+            inside &= std::fabs( lhs[i] - rhs[i] ) < margin;
+        }
+        return !inside;
+    }
+
+#ifdef CATCH_CONFIG_SSE2
+    inline bool anyOutsideEpsilon( double const* lhs, double const* rhs, std::size_t n, double epsilon, double scale ) {
+        __m128d const signBit = _mm_set1_pd( -0.0 );
+        __m128d const eps = _mm_set1_pd( epsilon );
+        __m128d const sc = _mm_set1_pd( scale );
+        __m128d inside = _mm_cmpeq_pd( eps, eps );
+        std::size_t i = 0;
+        for( ; i + 2 <= n; i += 2 ) {
+            __m128d l = _mm_loadu_pd( lhs + i );
+            __m128d r = _mm_loadu_pd( rhs + i );
+            __m128d margin = _mm_mul_pd( eps, _mm_add_pd( sc, _mm_max_pd( _mm_andnot_pd( signBit, l ), _mm_andnot_pd( signBit, r ) ) ) );
+            inside = _mm_and_pd( inside, _mm_cmplt_pd( _mm_andnot_pd( signBit, _mm_sub_pd( l, r ) ), margin ) );
+        }
+        return _mm_movemask_pd( inside ) != 0x3 || anyOutsideEpsilon<double>( lhs + i, rhs + i, n - i, epsilon, scale );
+    }
+    inline bool anyOutsideEpsilon( float const* lhs, float const* rhs, std::size_t n, float epsilon, float scale ) {
+        __m128 const signBit = _mm_set1_ps( -0.0f );
+        __m128 const eps = _mm_set1_ps( epsilon );
+        __m128 const sc = _mm_set1_ps( scale );
+        __m128 inside = _mm_cmpeq_ps( eps, eps );
+        std::size_t i = 0;
+        for( ; i + 4 <= n; i += 4 ) {
+            __m128 l = _mm_loadu_ps( lhs + i );
+            __m128 r = _mm_loadu_ps( rhs + i );
+            __m128 margin = _mm_mul_ps( eps, _mm_add_ps( sc, _mm_max_ps( _mm_andnot_ps( signBit, l ), _mm_andnot_ps( signBit, r ) ) ) );
+            inside = _mm_and_ps( inside, _mm_cmplt_ps( _mm_andnot_ps( signBit, _mm_sub_ps( l, r ) ), margin ) );
+        }
+        return _mm_movemask_ps( inside ) != 0xf || anyOutsideEpsilon<float>( lhs + i, rhs + i, n - i, epsilon, scale );
+    }
+#endif // CATCH_CONFIG_SSE2
 
-namespace Catch {
+    template<typename T>
+    class ApproxEquals : public MatcherImpl<ApproxEquals<T>, std::vector<T> > {
+        // Elements are compared a block at a time, and only a block with
+        // elements outside the epsilon margin is looked at element by element
+        enum { BlockSize = 256, MaxReportedIndices = 5 };
 
-    struct TagAlias {
-        TagAlias( std::string _tag, SourceLineInfo _lineInfo ) : tag( _tag ), lineInfo( _lineInfo ) {}
+    public:
+        // The expected values are referred to, not copied, so they have to
+        // outlive the matcher, as they do within a REQUIRE_THAT
+        explicit ApproxEquals( std::vector<T> const& comparator )
+        :   m_comparator( &comparator ),
+            m_epsilon( std::numeric_limits<float>::epsilon()*100 ),
+            m_scale( 1.0 ),
+            m_ulps( 0 )
+        {}
+        ApproxEquals( ApproxEquals const& other )
+        :   m_comparator( other.m_comparator ),
+            m_epsilon( other.m_epsilon ),
+            m_scale( other.m_scale ),
+            m_ulps( other.m_ulps )
+        {}
 
-        std::string tag;
-        SourceLineInfo lineInfo;
-    };
+        ApproxEquals& epsilon( double newEpsilon ) {
+            m_epsilon = newEpsilon;
+            return *this;
+        }
+
+        ApproxEquals& scale( double newScale ) {
+            m_scale = newScale;
+            return *this;
+        }
+
+        // Elements this many ulps apart or closer also match, even when they
+        // are outside the epsilon margin
+        ApproxEquals& ulps( unsigned int newUlps ) {
+            m_ulps = newUlps;
+            return *this;
+        }
+
+        virtual bool match( std::vector<T> const& expr ) const CATCH_OVERRIDE {
+            if( expr.size() != m_comparator->size() )
+                return false;
+            for( std::size_t begin = 0; begin < expr.size(); begin += BlockSize ) {
+                std::size_t end = (std::min)( begin + BlockSize, expr.size() );
+                if( !blockOutsideEpsilon( expr, begin, end ) )
+                    continue;
+                for( std::size_t i = begin; i < end; ++i )
+                    if( !withinMargin( expr[i], (*m_comparator)[i] ) )
+                        return false;
+            }
+            return true;
+        }
+
+        // Only the size and the margin are written, as the mismatches are
+        // what describeMismatch reports
+        virtual std::string toString() const CATCH_OVERRIDE {
+            std::ostringstream oss;
+            oss << "approx equals: " << m_comparator->size() << ( m_comparator->size() == 1 ? " element" : " elements" )
+                << " (epsilon " << Catch::toString( m_epsilon ) << ", scale " << Catch::toString( m_scale );
+            if( m_ulps != 0 )
+                oss << ", ulps " << m_ulps;
+            oss << ")";
+            return oss.str();
+        }
+
+        // The elements that differ are what describeMismatch reports, so the
+        // vector itself is only summarised
+        virtual std::string describeValue( std::vector<T> const& expr ) const CATCH_OVERRIDE {
+            std::ostringstream oss;
+            oss << "{ " << expr.size() << ( expr.size() == 1 ? " element }" : " elements }" );
+            return oss.str();
+        }
+
+        virtual std::string describeMismatch( std::vector<T> const& expr ) const CATCH_OVERRIDE {
+            std::ostringstream oss;
+            if( expr.size() != m_comparator->size() ) {
+                oss << "sizes differ: " << expr.size() << " elements against " << m_comparator->size() << " expected";
+                return oss.str();
+            }
+            std::size_t mismatches = 0;
+            std::size_t worst = 0;
+            double worstError = 0;
+            std::ostringstream differences;
+            for( std::size_t begin = 0; begin < expr.size(); begin += BlockSize ) {
+                std::size_t end = (std::min)( begin + BlockSize, expr.size() );
+                if( !blockOutsideEpsilon( expr, begin, end ) )
+                    continue;
+                for( std::size_t i = begin; i < end; ++i ) {
+                    if( withinMargin( expr[i], (*m_comparator)[i] ) )
+                        continue;
+                    double error = std::fabs( static_cast<double>( expr[i] ) - static_cast<double>( (*m_comparator)[i] ) );
+                    if( mismatches < MaxReportedIndices )
+                        differences << "\n  [" << i << "] " << Catch::toString( expr[i] ) << " against " << Catch::toString( (*m_comparator)[i] );
+                    // A NaN error is only reported when no element has a larger one
+                    if( mismatches == 0 || error > worstError || worstError != worstError ) {
+                        worst = i;
+                        worstError = error;
+                    }
+                    ++mismatches;
+                }
+            }
+            if( mismatches == 0 )
+                return std::string();
+
+            oss << mismatches << " of " << expr.size() << ( expr.size() == 1 ? " element differs" : " elements differ" )
+                << ", worst error " << Catch::toString( worstError ) << " at index " << worst
+                << differences.str();
+            if( mismatches > MaxReportedIndices )
+                oss << "\n  ...";
+            return oss.str();
+        }
+
+    private:
+        bool blockOutsideEpsilon( std::vector<T> const& expr, std::size_t begin, std::size_t end ) const {
+            return anyOutsideEpsilon( &expr[begin], &(*m_comparator)[begin], end - begin,
+                                      static_cast<T>( m_epsilon ), static_cast<T>( m_scale ) );
+        }
+
+        bool withinMargin( T lhs, T rhs ) const {
+            T const margin = static_cast<T>( m_epsilon ) * ( static_cast<T>( m_scale ) + (std::max)( std::fabs( lhs ), std::fabs( rhs ) ) );
+            if( std::fabs( lhs - rhs ) < margin )
+                return true;
+            if( m_ulps == 0 || lhs != lhs || rhs != rhs )
+                return false;
+            typename FloatingBits<T>::Type lhsBits = orderedBits( lhs ), rhsBits = orderedBits( rhs );
+            return ( lhsBits < rhsBits ? rhsBits - lhsBits : lhsBits - rhsBits ) <= m_ulps;
+        }
+
+        std::vector<T> const* m_comparator;
+        double m_epsilon;
+        double m_scale;
+        unsigned int m_ulps;
+    };
+
+} // namespace Floating
+} // namespace Impl
+
+    template<typename T>
+    inline Impl::Floating::ApproxEquals<T> ApproxEquals( std::vector<T> const& comparator ) {
+        return Impl::Floating::ApproxEquals<T>( comparator );
+    }
+
+} // namespace Matchers
+
+} // end namespace Catch
+
+// #included from: internal/catch_interfaces_tag_alias_registry.h
+#define TWOBLUECUBES_CATCH_INTERFACES_TAG_ALIAS_REGISTRY_H_INCLUDED
+
+// #included from: catch_tag_alias.h
+#define TWOBLUECUBES_CATCH_TAG_ALIAS_H_INCLUDED
+
+#include <string>
+
+namespace Catch {
+
+    struct TagAlias {
+        TagAlias( std::string _tag, SourceLineInfo _lineInfo ) : tag( _tag ), lineInfo( _lineInfo ) {}
+
+        std::string tag;
+        SourceLineInfo lineInfo;
+    };
 
     struct RegistrarForTagAliases {
         RegistrarForTagAliases( char const* alias, char const* tag, SourceLineInfo const& lineInfo );
@@ -2806,6 +3635,7 @@ namespace Catch {
 
 #include <string>
 #include <set>
+#include <vector>
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -2816,6 +3646,52 @@ namespace Catch {
 
     struct ITestCase;
 
+    // Gives each distinct lower case tag a small number, for TagBitset
+    std::size_t internTag( std::string const& lcaseTag );
+
+    // FNV-1a, so that every process hashes a name the same way on any platform
+    uint64_t hashTestName( std::string const& name );
+
+    // A set of tags held as one bit per interned tag, so that test specs can
+    // check a test case's tags with a few word operations
+    class TagBitset {
+    public:
+        void set( std::size_t id ) {
+            if( id/32 >= m_words.size() )
+                m_words.resize( id/32 + 1, 0 );
+            m_words[id/32] |= 1u << ( id%32 );
+        }
+        bool empty() const {
+            for( std::size_t i = 0; i < m_words.size(); ++i )
+                if( m_words[i] != 0 )
+                    return false;
+            return true;
+        }
+        bool containsAll( TagBitset const& other ) const {
+            for( std::size_t i = 0; i < other.m_words.size(); ++i ) {
+                unsigned int word = i < m_words.size() ? m_words[i] : 0;
+                if( ( word & other.m_words[i] ) != other.m_words[i] )
+                    return false;
+            }
+            return true;
+        }
+        bool intersects( TagBitset const& other ) const {
+            for( std::size_t i = 0; i < m_words.size() && i < other.m_words.size(); ++i )
+                if( ( m_words[i] & other.m_words[i] ) != 0 )
+                    return true;
+            return false;
+        }
+        void swap( TagBitset& other ) {
+            m_words.swap( other.m_words );
+        }
+        void clear() {
+            m_words.clear();
+        }
+
+    private:
+        std::vector<unsigned int> m_words;
+    };
+
     struct TestCaseInfo {
         enum SpecialProperties{
             None = 0,
@@ -2845,6 +3721,7 @@ namespace Catch {
         std::string description;
         std::set<std::string> tags;
         std::set<std::string> lcaseTags;
+        TagBitset tagBits;
         std::string tagsAsString;
         SourceLineInfo lineInfo;
         SpecialProperties properties;
@@ -3145,15 +4022,28 @@ namespace Catch
         }
         virtual ~WildcardPattern();
         virtual bool matches( std::string const& str ) const {
+            // Only case insensitive patterns need a copy of str to compare with
+            if( m_caseSensitivity == CaseSensitive::No )
+                return matchesAdjusted( toLower( str ) );
+            return matchesAdjusted( str );
+        }
+        bool isExact() const {
+            return m_wildcard == NoWildcard;
+        }
+        std::string const& pattern() const {
+            return m_pattern;
+        }
+    private:
+        bool matchesAdjusted( std::string const& str ) const {
             switch( m_wildcard ) {
                 case NoWildcard:
-                    return m_pattern == adjustCase( str );
+                    return m_pattern == str;
                 case WildcardAtStart:
-                    return endsWith( adjustCase( str ), m_pattern );
+                    return endsWith( str, m_pattern );
                 case WildcardAtEnd:
-                    return startsWith( adjustCase( str ), m_pattern );
+                    return startsWith( str, m_pattern );
                 case WildcardAtBothEnds:
-                    return contains( adjustCase( str ), m_pattern );
+                    return contains( str, m_pattern );
             }
 
 #ifdef __clang__
@@ -3165,7 +4055,6 @@ namespace Catch
 #pragma clang diagnostic pop
 #endif
         }
-    private:
         std::string adjustCase( std::string const& str ) const {
             return m_caseSensitivity == CaseSensitive::No ? toLower( str ) : str;
         }
@@ -3180,21 +4069,40 @@ namespace Catch
 
 namespace Catch {
 
+    // A spec is parsed into Patterns, as it always was, and each comma
+    // separated Filter of them is then lowered into a CompiledFilter: names
+    // are lower cased once, tags become bits of a TagBitset and plain names
+    // are looked up by their hash, so a long list of names, e.g. from
+    // --input-file, costs no more to match against than a short one. A
+    // Pattern that can't be lowered is still asked through matches()
     class TestSpec {
+        struct CompiledFilter;
+
+    public:
         struct Pattern : SharedImpl<> {
             virtual ~Pattern();
             virtual bool matches( TestCaseInfo const& testCase ) const = 0;
+
+            // Adds this pattern, negated if excluded, to filter, if it is
+            // one the compiled form has room for
+            virtual bool lowerInto( CompiledFilter&, bool ) const { return false; }
         };
         class NamePattern : public Pattern {
         public:
             NamePattern( std::string const& name )
-            : m_wildcardPattern( toLower( name ), CaseSensitive::No )
+            :   m_name( toLower( name ) ),
+                m_wildcardPattern( m_name, CaseSensitive::No )
             {}
             virtual ~NamePattern();
             virtual bool matches( TestCaseInfo const& testCase ) const {
                 return m_wildcardPattern.matches( toLower( testCase.name ) );
             }
+            virtual bool lowerInto( CompiledFilter& filter, bool excluded ) const {
+                ( excluded ? filter.excludedNames : filter.names ).push_back( WildcardPattern( m_name, CaseSensitive::Yes ) );
+                return true;
+            }
         private:
+            std::string m_name;
             WildcardPattern m_wildcardPattern;
         };
 
@@ -3205,6 +4113,10 @@ namespace Catch {
             virtual bool matches( TestCaseInfo const& testCase ) const {
                 return testCase.lcaseTags.find( m_tag ) != testCase.lcaseTags.end();
             }
+            virtual bool lowerInto( CompiledFilter& filter, bool excluded ) const {
+                ( excluded ? filter.excludedTags : filter.requiredTags ).set( internTag( m_tag ) );
+                return true;
+            }
         private:
             std::string m_tag;
         };
@@ -3214,10 +4126,14 @@ namespace Catch {
             ExcludedPattern( Ptr<Pattern> const& underlyingPattern ) : m_underlyingPattern( underlyingPattern ) {}
             virtual ~ExcludedPattern();
             virtual bool matches( TestCaseInfo const& testCase ) const { return !m_underlyingPattern->matches( testCase ); }
+            virtual bool lowerInto( CompiledFilter& filter, bool excluded ) const {
+                return m_underlyingPattern->lowerInto( filter, !excluded );
+            }
         private:
             Ptr<Pattern> m_underlyingPattern;
         };
 
+    private:
         struct Filter {
             std::vector<Ptr<Pattern> > m_patterns;
 
@@ -3231,20 +4147,77 @@ namespace Catch {
             }
         };
 
+        // A Filter as matched: a test case has to match every one of its
+        // names and tags, and any patterns that couldn't be lowered
+        struct CompiledFilter {
+            explicit CompiledFilter( Filter const& filter ) {
+                for( std::vector<Ptr<Pattern> >::const_iterator it = filter.m_patterns.begin(), itEnd = filter.m_patterns.end(); it != itEnd; ++it )
+                    if( !(*it)->lowerInto( *this, false ) )
+                        unlowered.push_back( *it );
+            }
+            bool isExactName() const {
+                return names.size() == 1 && names[0].isExact() && excludedNames.empty() &&
+                    requiredTags.empty() && excludedTags.empty() && unlowered.empty();
+            }
+            bool matches( TestCaseInfo const& testCase, std::string const& lcaseName ) const {
+                if( !testCase.tagBits.containsAll( requiredTags ) || testCase.tagBits.intersects( excludedTags ) )
+                    return false;
+                for( std::vector<WildcardPattern>::const_iterator it = names.begin(), itEnd = names.end(); it != itEnd; ++it )
+                    if( !it->matches( lcaseName ) )
+                        return false;
+                for( std::vector<WildcardPattern>::const_iterator it = excludedNames.begin(), itEnd = excludedNames.end(); it != itEnd; ++it )
+                    if( it->matches( lcaseName ) )
+                        return false;
+                for( std::vector<Ptr<Pattern> >::const_iterator it = unlowered.begin(), itEnd = unlowered.end(); it != itEnd; ++it )
+                    if( !(*it)->matches( testCase ) )
+                        return false;
+                return true;
+            }
+
+            std::vector<WildcardPattern> names; // Lower case
+            std::vector<WildcardPattern> excludedNames;
+            TagBitset requiredTags;
+            TagBitset excludedTags;
+            std::vector<Ptr<Pattern> > unlowered;
+        };
+
+        typedef std::pair<uint64_t, std::string> HashedName;
+
     public:
         bool hasFilters() const {
             return !m_filters.empty();
         }
         bool matches( TestCaseInfo const& testCase ) const {
             // A TestSpec matches if any filter matches
-            for( std::vector<Filter>::const_iterator it = m_filters.begin(), itEnd = m_filters.end(); it != itEnd; ++it )
-                if( it->matches( testCase ) )
+            std::string lcaseName = toLower( testCase.name );
+            if( !m_exactNames.empty() &&
+                    std::binary_search( m_exactNames.begin(), m_exactNames.end(), HashedName( hashTestName( lcaseName ), lcaseName ) ) )
+                return true;
+            for( std::vector<CompiledFilter>::const_iterator it = m_compiledFilters.begin(), itEnd = m_compiledFilters.end(); it != itEnd; ++it )
+                if( it->matches( testCase, lcaseName ) )
                     return true;
             return false;
         }
 
     private:
-        std::vector<Filter> m_filters;
+        void addFilter( Filter const& filter ) {
+            m_filters.push_back( filter );
+            CompiledFilter compiled( filter );
+            if( compiled.isExactName() ) {
+                std::string const& lcaseName = compiled.names[0].pattern();
+                m_exactNames.push_back( HashedName( hashTestName( lcaseName ), lcaseName ) );
+            }
+            else
+                m_compiledFilters.push_back( compiled );
+        }
+        void sortExactNames() {
+            std::sort( m_exactNames.begin(), m_exactNames.end() );
+            m_exactNames.erase( std::unique( m_exactNames.begin(), m_exactNames.end() ), m_exactNames.end() );
+        }
+
+        std::vector<Filter> m_filters; // As parsed
+        std::vector<CompiledFilter> m_compiledFilters; // Lowered from m_filters, bar exact names
+        std::vector<HashedName> m_exactNames; // Sorted by hash
 
         friend class TestSpecParser;
     };
@@ -3282,6 +4255,7 @@ namespace Catch {
         }
         TestSpec testSpec() {
             addFilter();
+            m_testSpec.sortExactNames();
             return m_testSpec;
         }
     private:
@@ -3336,7 +4310,7 @@ namespace Catch {
         }
         void addFilter() {
             if( !m_currentFilter.m_patterns.empty() ) {
-                m_testSpec.m_filters.push_back( m_currentFilter );
+                m_testSpec.addFilter( m_currentFilter );
                 m_currentFilter = TestSpec::Filter();
             }
         }
@@ -3379,7 +4353,8 @@ namespace Catch {
     struct RunTests { enum InWhatOrder {
         InDeclarationOrder,
         InLexicographicalOrder,
-        InRandomOrder
+        InRandomOrder,
+        InDurationOrder
     }; };
     struct UseColour { enum YesOrNo {
         Auto,
@@ -3406,6 +4381,18 @@ namespace Catch {
         virtual RunTests::InWhatOrder runOrder() const = 0;
         virtual unsigned int rngSeed() const = 0;
         virtual UseColour::YesOrNo useColour() const = 0;
+        virtual TimerClock::Type timerClock() const = 0;
+        virtual int benchmarkSamples() const = 0;
+        virtual int benchmarkWarmupTime() const = 0;
+        virtual BenchmarkBaseline const* benchmarkBaseline() const = 0;
+        virtual double benchmarkRegressionThreshold() const = 0;
+        virtual int shardCount() const = 0;
+        virtual int shardIndex() const = 0;
+        virtual std::string durationsFile() const = 0;
+        virtual bool captureFileDescriptors() const = 0;
+        virtual std::size_t outputCaptureLimit() const = 0;
+        virtual std::size_t containerLimit() const = 0;
+        virtual std::size_t diffContext() const = 0;
     };
 }
 
@@ -3428,6 +4415,7 @@ namespace Catch {
 #include <streambuf>
 #include <ostream>
 #include <fstream>
+#include <cstdio>
 
 namespace Catch {
 
@@ -3442,7 +4430,7 @@ namespace Catch {
     class FileStream : public IStream {
         mutable std::ofstream m_ofs;
     public:
-        FileStream( std::string const& filename );
+        FileStream( std::string const& filename, bool binary = false );
         virtual ~FileStream() CATCH_NOEXCEPT;
     public: // IStream
         virtual std::ostream& stream() const CATCH_OVERRIDE;
@@ -3468,6 +4456,94 @@ namespace Catch {
     public: // IStream
         virtual std::ostream& stream() const CATCH_OVERRIDE;
     };
+
+    // Gathers output into large blocks for another streambuf and ignores the
+    // flushes that std::endl asks for, so that each line of a report doesn't
+    // cost a write. Output only goes out on flushBlock(), or as blocks fill
+    class BlockBufferedStreamBuf : public StreamBufBase {
+    public:
+        explicit BlockBufferedStreamBuf( std::streambuf* target );
+        virtual ~BlockBufferedStreamBuf() CATCH_NOEXCEPT;
+
+        void flushBlock();
+
+    private:
+        virtual int overflow( int c ) CATCH_OVERRIDE;
+        virtual int sync() CATCH_OVERRIDE;
+        void writeBlock();
+
+        std::streambuf* m_target;
+        std::vector<char> m_block;
+    };
+
+    // For --buffer-output: block buffers another stream. When that is the
+    // console, Catch::cout() is routed through the same buffer, so colour
+    // codes and anything the tests print stay in order with the report, and
+    // the buffer is written out before anything goes to Catch::cerr()
+    class BufferedStream : public IStream {
+        CATCH_AUTO_PTR( IStream const ) m_inner;
+        CATCH_AUTO_PTR( BlockBufferedStreamBuf ) m_streamBuf;
+        mutable std::ostream m_os;
+        CATCH_AUTO_PTR( StreamBufBase ) m_cerrBuf;
+        std::streambuf* m_prevCoutBuf;
+        std::streambuf* m_prevCerrBuf;
+    public:
+        BufferedStream( IStream const* inner, bool sharedWithCout );
+        virtual ~BufferedStream() CATCH_NOEXCEPT;
+
+    public: // IStream
+        virtual std::ostream& stream() const CATCH_OVERRIDE;
+    };
+
+    // Writes out whatever the BufferedStream, if any, is holding. Called as
+    // each test case ends, and before exiting on a fatal condition
+    void flushBufferedOutput();
+
+    // An anonymous temporary file, for output that has to be held back until
+    // something written after it is known, without holding it in memory.
+    // The file goes away with this object. Where no temporary file can be
+    // created (MSVC's tmpfile() wants to write to the root of the drive) the
+    // output is held in memory instead
+    class TempFileStream : public IStream {
+        std::FILE* m_file;
+        std::string m_memory;
+        CATCH_AUTO_PTR( StreamBufBase ) m_streamBuf;
+        mutable std::ostream m_os;
+    public:
+        TempFileStream();
+        virtual ~TempFileStream() CATCH_NOEXCEPT;
+
+        // Bytes written so far
+        std::size_t size() const;
+
+        // Reads back the block that starts at offset, moving offset past it.
+        // Returns false once everything written so far has been read
+        bool readBlock( std::size_t& offset, std::string& block ) const;
+
+        // Copies the bytes in [from, to) to os
+        void copyTo( std::ostream& os, std::size_t from, std::size_t to ) const;
+
+    public: // IStream
+        virtual std::ostream& stream() const CATCH_OVERRIDE;
+    };
+
+    // For --out with a .gz suffix: gzip compresses the report as it is
+    // written, a block at a time, so the uncompressed report is never held
+    class GzipFileStream : public IStream {
+        mutable std::ofstream m_ofs;
+        CATCH_AUTO_PTR( StreamBufBase ) m_streamBuf;
+        mutable std::ostream m_os;
+    public:
+        explicit GzipFileStream( std::string const& filename );
+        virtual ~GzipFileStream() CATCH_NOEXCEPT;
+
+    public: // IStream
+        virtual std::ostream& stream() const CATCH_OVERRIDE;
+    };
+
+    // Completes the .gz output, if any, so that it can be read after exiting
+    // on a fatal condition
+    void finishCompressedOutput();
 }
 
 #include <memory>
@@ -3475,6 +4551,7 @@ namespace Catch {
 #include <string>
 #include <iostream>
 #include <ctime>
+#include <algorithm>
 
 #ifndef CATCH_CONFIG_CONSOLE_WIDTH
 #define CATCH_CONFIG_CONSOLE_WIDTH 80
@@ -3495,13 +4572,27 @@ namespace Catch {
             showHelp( false ),
             showInvisibles( false ),
             filenamesAsTags( false ),
+            bufferOutput( false ),
+            captureFileDescriptors( false ),
+            asyncReporter( false ),
             abortAfter( -1 ),
             rngSeed( 0 ),
+            jobs( 1 ),
+            shardCount( 1 ),
+            shardIndex( 0 ),
+            partitions( 0 ),
+            benchmarkSamples( 100 ),
+            benchmarkWarmupTime( 100 ),
+            benchmarkRegressionThreshold( 5 ),
+            outputCaptureLimit( 0 ),
+            containerLimit( 100 ),
+            diffContext( 5 ),
             verbosity( Verbosity::Normal ),
             warnings( WarnAbout::Nothing ),
             showDurations( ShowDurations::DefaultForReporter ),
             runOrder( RunTests::InDeclarationOrder ),
-            useColour( UseColour::Auto )
+            useColour( UseColour::Auto ),
+            timerClock( TimerClock::Wall )
         {}
 
         bool listTests;
@@ -3515,24 +4606,54 @@ namespace Catch {
         bool showHelp;
         bool showInvisibles;
         bool filenamesAsTags;
+        bool bufferOutput;
+        bool captureFileDescriptors;
+        bool asyncReporter;
 
         int abortAfter;
         unsigned int rngSeed;
+        int jobs;
+        int shardCount;
+        int shardIndex;
+        int partitions;
+        int benchmarkSamples;
+        int benchmarkWarmupTime;
+        double benchmarkRegressionThreshold;
+        int outputCaptureLimit;
+        int containerLimit;
+        int diffContext;
 
         Verbosity::Level verbosity;
         WarnAbout::What warnings;
         ShowDurations::OrNot showDurations;
         RunTests::InWhatOrder runOrder;
         UseColour::YesOrNo useColour;
+        TimerClock::Type timerClock;
 
         std::string outputFilename;
         std::string name;
         std::string processName;
+        std::string benchmarkSaveFile;
+        std::string benchmarkCompareFile;
+        std::string durationsFile;
+        std::string replayFile;
 
         std::vector<std::string> reporterNames;
         std::vector<std::string> testsOrTags;
     };
 
+    // A file that is only written once the run is over is checked up front,
+    // so a bad path fails straight away rather than after every test has run
+    inline void checkWritable( std::string const& filename, std::string const& description ) {
+        bool existed = std::ifstream( filename.c_str() ).good();
+        std::ofstream f( filename.c_str(), std::ios::app );
+        if( !f )
+            throw std::domain_error( "Unable to write " + description + " file: " + filename );
+        f.close();
+        if( !existed )
+            std::remove( filename.c_str() );
+    }
+
     class Config : public SharedImpl<IConfig> {
     private:
         Config( Config const& other );
@@ -3553,6 +4674,14 @@ namespace Catch {
                     parser.parse( data.testsOrTags[i] );
                 m_testSpec = parser.testSpec();
             }
+            if( !data.benchmarkSaveFile.empty() )
+                checkWritable( data.benchmarkSaveFile, "benchmark baseline" );
+            if( !data.durationsFile.empty() )
+                checkWritable( data.durationsFile, "test durations" );
+            // Loaded once here, so a bad baseline stops the run before it
+            // starts, and --jobs workers get it along with the rest of the config
+            if( !data.benchmarkCompareFile.empty() )
+                m_benchmarkBaseline.load( data.benchmarkCompareFile );
         }
 
         virtual ~Config() {
@@ -3566,6 +4695,8 @@ namespace Catch {
         bool listTestNamesOnly() const { return m_data.listTestNamesOnly; }
         bool listTags() const { return m_data.listTags; }
         bool listReporters() const { return m_data.listReporters; }
+        int partitions() const { return m_data.partitions; }
+        std::string const& replayFile() const { return m_data.replayFile; }
 
         std::string getProcessName() const { return m_data.processName; }
 
@@ -3574,6 +4705,9 @@ namespace Catch {
         std::vector<std::string> getReporterNames() const { return m_data.reporterNames; }
 
         int abortAfter() const { return m_data.abortAfter; }
+        int jobs() const { return m_data.jobs; }
+        bool asyncReporter() const { return m_data.asyncReporter; }
+        std::string const& benchmarkSaveFile() const { return m_data.benchmarkSaveFile; }
 
         TestSpec const& testSpec() const { return m_testSpec; }
 
@@ -3590,10 +4724,29 @@ namespace Catch {
         virtual RunTests::InWhatOrder runOrder() const  { return m_data.runOrder; }
         virtual unsigned int rngSeed() const    { return m_data.rngSeed; }
         virtual UseColour::YesOrNo useColour() const { return m_data.useColour; }
+        virtual TimerClock::Type timerClock() const { return m_data.timerClock; }
+        virtual int benchmarkSamples() const    { return m_data.benchmarkSamples; }
+        virtual int benchmarkWarmupTime() const { return m_data.benchmarkWarmupTime; }
+        virtual BenchmarkBaseline const* benchmarkBaseline() const {
+            return m_data.benchmarkCompareFile.empty() ? CATCH_NULL : &m_benchmarkBaseline;
+        }
+        virtual double benchmarkRegressionThreshold() const { return m_data.benchmarkRegressionThreshold; }
+        virtual int shardCount() const          { return m_data.shardCount; }
+        virtual int shardIndex() const          { return m_data.shardIndex; }
+        virtual std::string durationsFile() const { return m_data.durationsFile; }
+        virtual bool captureFileDescriptors() const { return m_data.captureFileDescriptors; }
+        virtual std::size_t outputCaptureLimit() const { return static_cast<std::size_t>( m_data.outputCaptureLimit ); }
+        virtual std::size_t containerLimit() const { return static_cast<std::size_t>( m_data.containerLimit ); }
+        virtual std::size_t diffContext() const { return static_cast<std::size_t>( m_data.diffContext ); }
 
     private:
 
         IStream const* openStream() {
+            if( m_data.bufferOutput )
+                return new BufferedStream( openUnbufferedStream(), m_data.outputFilename.empty() );
+            return openUnbufferedStream();
+        }
+        IStream const* openUnbufferedStream() {
             if( m_data.outputFilename.empty() )
                 return new CoutStream();
             else if( m_data.outputFilename[0] == '%' ) {
@@ -3602,13 +4755,20 @@ namespace Catch {
                 else
                     throw std::domain_error( "Unrecognised stream: " + m_data.outputFilename );
             }
+            else if( endsWith( m_data.outputFilename, ".gz" ) )
+                return new GzipFileStream( m_data.outputFilename );
             else
-                return new FileStream( m_data.outputFilename );
+                return new FileStream( m_data.outputFilename, writesEventLog() );
+        }
+        // An event log is binary, so mustn't have its line endings translated
+        bool writesEventLog() const {
+            return std::find( m_data.reporterNames.begin(), m_data.reporterNames.end(), "eventlog" ) != m_data.reporterNames.end();
         }
         ConfigData m_data;
 
         CATCH_AUTO_PTR( IStream const ) m_stream;
         TestSpec m_testSpec;
+        BenchmarkBaseline m_benchmarkBaseline;
     };
 
 } // end namespace Catch
@@ -4673,6 +5833,8 @@ namespace Catch {
             config.runOrder = RunTests::InLexicographicalOrder;
         else if( startsWith( "random", order ) )
             config.runOrder = RunTests::InRandomOrder;
+        else if( startsWith( "duration", order ) )
+            config.runOrder = RunTests::InDurationOrder;
         else
             throw std::runtime_error( "Unrecognised ordering: '" + order + "'" );
     }
@@ -4688,6 +5850,56 @@ namespace Catch {
                 throw std::runtime_error( "Argment to --rng-seed should be the word 'time' or a number" );
         }
     }
+    inline void setJobs( ConfigData& config, int jobs ) {
+        if( jobs < 1 )
+            throw std::runtime_error( "Value after -j or --jobs must be greater than zero" );
+        config.jobs = jobs;
+    }
+    inline void setShardCount( ConfigData& config, int count ) {
+        if( count < 1 )
+            throw std::runtime_error( "Value after --shard-count must be greater than zero" );
+        config.shardCount = count;
+    }
+    inline void setPartitions( ConfigData& config, int partitions ) {
+        if( partitions < 1 )
+            throw std::runtime_error( "Value after --partition must be greater than zero" );
+        config.partitions = partitions;
+    }
+    inline void setShardIndex( ConfigData& config, int index ) {
+        if( index < 0 )
+            throw std::runtime_error( "Value after --shard-index must not be negative" );
+        config.shardIndex = index;
+    }
+    inline void setBenchmarkSamples( ConfigData& config, int samples ) {
+        if( samples < 1 )
+            throw std::runtime_error( "Value after --benchmark-samples must be greater than zero" );
+        config.benchmarkSamples = samples;
+    }
+    inline void setBenchmarkWarmupTime( ConfigData& config, int milliseconds ) {
+        if( milliseconds < 0 )
+            throw std::runtime_error( "Value after --benchmark-warmup-time must not be negative" );
+        config.benchmarkWarmupTime = milliseconds;
+    }
+    inline void setBenchmarkRegressionThreshold( ConfigData& config, double percent ) {
+        if( percent < 0 )
+            throw std::runtime_error( "Value after --benchmark-threshold must not be negative" );
+        config.benchmarkRegressionThreshold = percent;
+    }
+    inline void setOutputCaptureLimit( ConfigData& config, int bytes ) {
+        if( bytes < 0 )
+            throw std::runtime_error( "Value after --capture-limit must not be negative" );
+        config.outputCaptureLimit = bytes;
+    }
+    inline void setContainerLimit( ConfigData& config, int elements ) {
+        if( elements < 0 )
+            throw std::runtime_error( "Value after --container-limit must not be negative" );
+        config.containerLimit = elements;
+    }
+    inline void setDiffContext( ConfigData& config, int elements ) {
+        if( elements < 0 )
+            throw std::runtime_error( "Value after --diff-context must not be negative" );
+        config.diffContext = elements;
+    }
     inline void setVerbosity( ConfigData& config, int level ) {
         // !TBD: accept strings?
         config.verbosity = static_cast<Verbosity::Level>( level );
@@ -4709,6 +5921,14 @@ namespace Catch {
         else
             throw std::runtime_error( "colour mode must be one of: auto, yes or no" );
     }
+    inline void setTimerClock( ConfigData& config, std::string const& clock ) {
+        if( startsWith( "wall", clock ) )
+            config.timerClock = TimerClock::Wall;
+        else if( startsWith( "cpu", clock ) )
+            config.timerClock = TimerClock::ThreadCpu;
+        else
+            throw std::runtime_error( "Unrecognised clock: '" + clock + "'" );
+    }
     inline void forceColour( ConfigData& config ) {
         config.useColour = UseColour::Yes;
     }
@@ -4811,6 +6031,10 @@ namespace Catch {
             .describe( "adds a tag for the filename" )
             .bind( &ConfigData::filenamesAsTags );
 
+        cli["-j"]["--jobs"]
+            .describe( "run test cases in this many worker processes" )
+            .bind( &setJobs, "no. workers" );
+
         // Less common commands which don't have a short form
         cli["--list-test-names-only"]
             .describe( "list all/matching test cases names only" )
@@ -4822,12 +6046,80 @@ namespace Catch {
 
         cli["--order"]
             .describe( "test case order (defaults to decl)" )
-            .bind( &setOrder, "decl|lex|rand" );
+            .bind( &setOrder, "decl|lex|rand|duration" );
 
         cli["--rng-seed"]
             .describe( "set a specific seed for random numbers" )
             .bind( &setRngSeed, "'time'|number" );
 
+        cli["--shard-count"]
+            .describe( "split the matching test cases into this many shards" )
+            .bind( &setShardCount, "shards" );
+
+        cli["--shard-index"]
+            .describe( "run only this shard of the test cases (from 0)" )
+            .bind( &setShardIndex, "shard" );
+
+        cli["--durations-file"]
+            .describe( "file of test case durations to order and balance by, updated after each run" )
+            .bind( &ConfigData::durationsFile, "filename" );
+
+        cli["--partition"]
+            .describe( "list the test cases split into this many groups of similar duration" )
+            .bind( &setPartitions, "groups" );
+
+        cli["--replay"]
+            .describe( "report on a run recorded by the eventlog reporter instead of running tests" )
+            .bind( &ConfigData::replayFile, "filename" );
+
+        cli["--clock"]
+            .describe( "clock to time tests with (defaults to wall)" )
+            .bind( &setTimerClock, "wall|cpu" );
+
+        cli["--benchmark-samples"]
+            .describe( "number of samples to take per benchmark (defaults to 100)" )
+            .bind( &setBenchmarkSamples, "samples" );
+
+        cli["--benchmark-warmup-time"]
+            .describe( "time to run each benchmark before sampling (defaults to 100)" )
+            .bind( &setBenchmarkWarmupTime, "milliseconds" );
+
+        cli["--benchmark-save"]
+            .describe( "save benchmark samples to a baseline file" )
+            .bind( &ConfigData::benchmarkSaveFile, "filename" );
+
+        cli["--benchmark-compare"]
+            .describe( "fail benchmarks that are slower than in a baseline file" )
+            .bind( &ConfigData::benchmarkCompareFile, "filename" );
+
+        cli["--benchmark-threshold"]
+            .describe( "slowdown allowed against the baseline (defaults to 5)" )
+            .bind( &setBenchmarkRegressionThreshold, "percent" );
+
+        cli["--buffer-output"]
+            .describe( "write output in blocks, at the end of each test case" )
+            .bind( &ConfigData::bufferOutput );
+
+        cli["--capture-fd"]
+            .describe( "capture test output at the file descriptor level, including printf (Linux only)" )
+            .bind( &ConfigData::captureFileDescriptors );
+
+        cli["--capture-limit"]
+            .describe( "keep only the first and last half of this much of each test's output (defaults to 0, no limit)" )
+            .bind( &setOutputCaptureLimit, "bytes" );
+
+        cli["--container-limit"]
+            .describe( "write at most this many elements of a container (defaults to 100, 0 for no limit)" )
+            .bind( &setContainerLimit, "elements" );
+
+        cli["--diff-context"]
+            .describe( "elements shown either side of the first difference between large containers (defaults to 5)" )
+            .bind( &setDiffContext, "elements" );
+
+        cli["--async-reporter"]
+            .describe( "run reporters that capture test output on a thread of their own" )
+            .bind( &ConfigData::asyncReporter );
+
         cli["--force-colour"]
             .describe( "force colourised output (deprecated)" )
             .bind( &forceColour );
@@ -4898,55 +6190,70 @@ namespace Tbc {
         char tabChar;               // If this char is seen the indent is changed to current pos
     };
 
+    // Lays the text out in one pass, as spans of the string rather than
+    // copies of each line, which are written straight to the stream
     class Text {
     public:
         Text( std::string const& _str, TextAttributes const& _attr = TextAttributes() )
-        : attr( _attr )
+        :   str( _str ),
+            attr( _attr ),
+            truncated( false )
         {
-            std::string wrappableChars = " [({.,/|\\-";
+            char const tabChars[] = { _attr.tabChar, '\0' };
             std::size_t indent = _attr.initialIndent != std::string::npos
                 ? _attr.initialIndent
                 : _attr.indent;
-            std::string remainder = _str;
+            std::size_t pos = 0;
 
-            while( !remainder.empty() ) {
+            while( pos < str.size() ) {
                 if( lines.size() >= 1000 ) {
-                    lines.push_back( "... message truncated due to excessive size" );
+                    truncated = true;
                     return;
                 }
+                std::size_t remaining = str.size() - pos;
                 std::size_t tabPos = std::string::npos;
-                std::size_t width = (std::min)( remainder.size(), _attr.width - indent );
-                std::size_t pos = remainder.find_first_of( '\n' );
-                if( pos <= width ) {
-                    width = pos;
+                std::size_t width = (std::min)( remaining, _attr.width - indent );
+                // Only the first wrap's worth of the rest of the text is ever looked at
+                std::size_t lastInWindow = pos + (std::min)( width, remaining - 1 );
+                std::size_t found = static_cast<std::size_t>(
+                    std::find( str.begin() + pos, str.begin() + lastInWindow + 1, '\n' ) - str.begin() );
+                if( found <= lastInWindow ) {
+                    width = found - pos;
+                    lastInWindow = found;
                 }
-                pos = remainder.find_last_of( _attr.tabChar, width );
-                if( pos != std::string::npos ) {
-                    tabPos = pos;
-                    if( remainder[width] == '\n' )
+                found = findLastOf( tabChars, pos, lastInWindow );
+                if( found != std::string::npos ) {
+                    tabPos = found - pos;
+                    if( charAt( pos + width ) == '\n' )
                         width--;
-                    remainder = remainder.substr( 0, tabPos ) + remainder.substr( tabPos+1 );
+                    str.erase( found, 1 );
+                    remaining--;
                 }
 
-                if( width == remainder.size() ) {
-                    spliceLine( indent, remainder, width );
+                if( width == remaining ) {
+                    addLine( indent, pos, width );
+                    pos += width;
                 }
-                else if( remainder[width] == '\n' ) {
-                    spliceLine( indent, remainder, width );
-                    if( width <= 1 || remainder.size() != 1 )
-                        remainder = remainder.substr( 1 );
+                else if( charAt( pos + width ) == '\n' ) {
+                    addLine( indent, pos, width );
+                    pos += width;
+                    if( width <= 1 || remaining - width != 1 )
+                        pos++;
                     indent = _attr.indent;
                 }
                 else {
-                    pos = remainder.find_last_of( wrappableChars, width );
-                    if( pos != std::string::npos && pos > 0 ) {
-                        spliceLine( indent, remainder, pos );
-                        if( remainder[0] == ' ' )
-                            remainder = remainder.substr( 1 );
+                    found = findLastOf( " [({.,/|\\-", pos, pos + (std::min)( width, remaining - 1 ) );
+                    if( found != std::string::npos && found > pos ) {
+                        addLine( indent, pos, found - pos );
+                        pos = found;
+                        if( str[pos] == ' ' )
+                            pos++;
                     }
                     else {
-                        spliceLine( indent, remainder, width-1 );
-                        lines.back() += "-";
+                        std::size_t length = width > 0 ? width-1 : remaining;
+                        addLine( indent, pos, length );
+                        lines.back().hyphenated = true;
+                        pos += length;
                     }
                     if( lines.size() == 1 )
                         indent = _attr.indent;
@@ -4956,18 +6263,15 @@ namespace Tbc {
             }
         }
 
-        void spliceLine( std::size_t _indent, std::string& _remainder, std::size_t _pos ) {
-            lines.push_back( std::string( _indent, ' ' ) + _remainder.substr( 0, _pos ) );
-            _remainder = _remainder.substr( _pos );
-        }
-
         typedef std::vector<std::string>::const_iterator const_iterator;
 
-        const_iterator begin() const { return lines.begin(); }
-        const_iterator end() const { return lines.end(); }
-        std::string const& last() const { return lines.back(); }
-        std::size_t size() const { return lines.size(); }
-        std::string const& operator[]( std::size_t _index ) const { return lines[_index]; }
+        // Each line is only made into a string, all of them at once, when one
+        // is asked for here. The stream operator writes the spans instead
+        const_iterator begin() const { return lineStrings().begin(); }
+        const_iterator end() const { return lineStrings().end(); }
+        std::string const& last() const { return lineStrings().back(); }
+        std::size_t size() const { return lines.size() + ( truncated ? 1 : 0 ); }
+        std::string const& operator[]( std::size_t _index ) const { return lineStrings()[_index]; }
         std::string toString() const {
             std::ostringstream oss;
             oss << *this;
@@ -4975,19 +6279,75 @@ namespace Tbc {
         }
 
         inline friend std::ostream& operator << ( std::ostream& _stream, Text const& _text ) {
-            for( Text::const_iterator it = _text.begin(), itEnd = _text.end();
+            static char const spaces[] = "                                ";
+            for( std::vector<Line>::const_iterator it = _text.lines.begin(), itEnd = _text.lines.end();
                 it != itEnd; ++it ) {
-                if( it != _text.begin() )
-                    _stream << "\n";
-                _stream << *it;
+                if( it != _text.lines.begin() )
+                    _stream.put( '\n' );
+                for( std::size_t indent = it->indent; indent > 0; ) {
+                    std::size_t chunk = (std::min)( indent, sizeof( spaces ) - 1 );
+                    _stream.write( spaces, static_cast<std::streamsize>( chunk ) );
+                    indent -= chunk;
+                }
+                _stream.write( _text.str.data() + it->start, static_cast<std::streamsize>( it->length ) );
+                if( it->hyphenated )
+                    _stream.put( '-' );
+            }
+            if( _text.truncated ) {
+                if( !_text.lines.empty() )
+                    _stream.put( '\n' );
+                _stream << truncationMessage();
             }
             return _stream;
         }
 
     private:
-        std::string str;
+        struct Line {
+            std::size_t indent;
+            std::size_t start;
+            std::size_t length;
+            bool hyphenated;
+        };
+
+        static char const* truncationMessage() {
+            return "... message truncated due to excessive size";
+        }
+        std::vector<std::string> const& lineStrings() const {
+            if( strings.size() != size() ) {
+                strings.clear();
+                strings.reserve( size() );
+                for( std::vector<Line>::const_iterator it = lines.begin(), itEnd = lines.end(); it != itEnd; ++it ) {
+                    strings.push_back( std::string( it->indent, ' ' ) );
+                    strings.back().append( str, it->start, it->length );
+                    if( it->hyphenated )
+                        strings.back() += '-';
+                }
+                if( truncated )
+                    strings.push_back( truncationMessage() );
+            }
+            return strings;
+        }
+        // Like find_last_of, but never looks back past the start of the current line
+        std::size_t findLastOf( char const* _chars, std::size_t _from, std::size_t _to ) const {
+            for( std::size_t i = _to + 1; i > _from; --i )
+                for( char const* c = _chars; *c; ++c )
+                    if( str[i-1] == *c )
+                        return i-1;
+            return std::string::npos;
+        }
+        char charAt( std::size_t _pos ) const {
+            return _pos < str.size() ? str[_pos] : '\0';
+        }
+        void addLine( std::size_t _indent, std::size_t _start, std::size_t _length ) {
+            Line line = { _indent, _start, _length, false };
+            lines.push_back( line );
+        }
+
+        std::string str; // Copied, as tab characters are taken out while laying it out
         TextAttributes attr;
-        std::vector<std::string> lines;
+        std::vector<Line> lines;
+        bool truncated;
+        mutable std::vector<std::string> strings; // lines as strings, made by lineStrings()
     };
 
 } // end namespace Tbc
@@ -5088,10 +6448,15 @@ namespace Catch
 
     struct ReporterPreferences {
         ReporterPreferences()
-        : shouldRedirectStdOut( false )
+        : shouldRedirectStdOut( false ),
+          shouldReportAllAssertions( false )
         {}
 
         bool shouldRedirectStdOut;
+        // Unless -s is given, passing assertions are only counted and
+        // assertionEnded() is not called for them, for reporters and listeners
+        // alike. One that sets this is sent every one of them regardless
+        bool shouldReportAllAssertions;
     };
 
     template<typename T>
@@ -5138,11 +6503,10 @@ namespace Catch
             if( assertionResult.hasMessage() ) {
                 // Copy message into messages list.
                 // !TBD This should have been done earlier, somewhere
-                MessageBuilder builder( assertionResult.getTestMacroName(), assertionResult.getSourceInfo(), assertionResult.getResultType() );
-                builder << assertionResult.getMessage();
-                builder.m_info.message = builder.m_stream.str();
+                MessageInfo info( assertionResult.getTestMacroName(), assertionResult.getSourceInfo(), assertionResult.getResultType() );
+                info.message = assertionResult.getMessage();
 
-                infoMessages.push_back( builder.m_info );
+                infoMessages.push_back( info );
             }
         }
         virtual ~AssertionStats();
@@ -5162,11 +6526,11 @@ namespace Catch
     struct SectionStats {
         SectionStats(   SectionInfo const& _sectionInfo,
                         Counts const& _assertions,
-                        double _durationInSeconds,
+                        uint64_t _durationInNanoseconds,
                         bool _missingAssertions )
         :   sectionInfo( _sectionInfo ),
             assertions( _assertions ),
-            durationInSeconds( _durationInSeconds ),
+            durationInNanoseconds( _durationInNanoseconds ),
             missingAssertions( _missingAssertions )
         {}
         virtual ~SectionStats();
@@ -5179,7 +6543,7 @@ namespace Catch
 
         SectionInfo sectionInfo;
         Counts assertions;
-        double durationInSeconds;
+        uint64_t durationInNanoseconds;
         bool missingAssertions;
     };
 
@@ -5188,12 +6552,14 @@ namespace Catch
                         Totals const& _totals,
                         std::string const& _stdOut,
                         std::string const& _stdErr,
-                        bool _aborting )
+                        bool _aborting,
+                        uint64_t _durationInNanoseconds )
         : testInfo( _testInfo ),
             totals( _totals ),
             stdOut( _stdOut ),
             stdErr( _stdErr ),
-            aborting( _aborting )
+            aborting( _aborting ),
+            durationInNanoseconds( _durationInNanoseconds )
         {}
         virtual ~TestCaseStats();
 
@@ -5209,6 +6575,7 @@ namespace Catch
         std::string stdOut;
         std::string stdErr;
         bool aborting;
+        uint64_t durationInNanoseconds;
     };
 
     struct TestGroupStats {
@@ -5288,6 +6655,9 @@ namespace Catch
         // The return value indicates if the messages buffer should be cleared:
         virtual bool assertionEnded( AssertionStats const& assertionStats ) = 0;
 
+        // Not pure, so reporters written before BENCHMARK existed still compile
+        virtual void benchmarkEnded( BenchmarkStats const& ) {}
+
         virtual void sectionEnded( SectionStats const& sectionStats ) = 0;
         virtual void testCaseEnded( TestCaseStats const& testCaseStats ) = 0;
         virtual void testGroupEnded( TestGroupStats const& testGroupStats ) = 0;
@@ -5338,20 +6708,24 @@ namespace Catch {
         nameAttr.setInitialIndent( 2 ).setIndent( 4 );
         tagsAttr.setIndent( 6 );
 
-        std::vector<TestCase> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
-        for( std::vector<TestCase>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
+        std::vector<TestCase const*> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
+        for( std::vector<TestCase const*>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
                 it != itEnd;
                 ++it ) {
             matchedTests++;
-            TestCaseInfo const& testCaseInfo = it->getTestCaseInfo();
+            TestCaseInfo const& testCaseInfo = (*it)->getTestCaseInfo();
             Colour::Code colour = testCaseInfo.isHidden()
                 ? Colour::SecondaryText
                 : Colour::None;
             Colour colourGuard( colour );
 
-            Catch::cout() << Text( testCaseInfo.name, nameAttr ) << std::endl;
+            Catch::cout() << Text( testCaseInfo.name, nameAttr ) << '\n';
             if( !testCaseInfo.tags.empty() )
-                Catch::cout() << Text( testCaseInfo.tagsAsString, tagsAttr ) << std::endl;
+                Catch::cout() << Text( testCaseInfo.tagsAsString, tagsAttr ) << '\n';
+            // Flushing once per test dominated listing large suites, so only
+            // do so when a console colour has to be reset after the text
+            if( colour != Colour::None )
+                Catch::cout().flush();
         }
 
         if( !config.testSpec().hasFilters() )
@@ -5366,17 +6740,18 @@ namespace Catch {
         if( !config.testSpec().hasFilters() )
             testSpec = TestSpecParser( ITagAliasRegistry::get() ).parse( "*" ).testSpec();
         std::size_t matchedTests = 0;
-        std::vector<TestCase> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
-        for( std::vector<TestCase>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
+        std::vector<TestCase const*> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
+        for( std::vector<TestCase const*>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
                 it != itEnd;
                 ++it ) {
             matchedTests++;
-            TestCaseInfo const& testCaseInfo = it->getTestCaseInfo();
+            TestCaseInfo const& testCaseInfo = (*it)->getTestCaseInfo();
             if( startsWith( testCaseInfo.name, "#" ) )
-               Catch::cout() << "\"" << testCaseInfo.name << "\"" << std::endl;
+               Catch::cout() << "\"" << testCaseInfo.name << "\"\n";
             else
-               Catch::cout() << testCaseInfo.name << std::endl;
+               Catch::cout() << testCaseInfo.name << '\n';
         }
+        Catch::cout().flush();
         return matchedTests;
     }
 
@@ -5409,12 +6784,12 @@ namespace Catch {
 
         std::map<std::string, TagInfo> tagCounts;
 
-        std::vector<TestCase> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
-        for( std::vector<TestCase>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
+        std::vector<TestCase const*> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
+        for( std::vector<TestCase const*>::const_iterator it = matchedTestCases.begin(), itEnd = matchedTestCases.end();
                 it != itEnd;
                 ++it ) {
-            for( std::set<std::string>::const_iterator  tagIt = it->getTestCaseInfo().tags.begin(),
-                                                        tagItEnd = it->getTestCaseInfo().tags.end();
+            for( std::set<std::string>::const_iterator  tagIt = (*it)->getTestCaseInfo().tags.begin(),
+                                                        tagItEnd = (*it)->getTestCaseInfo().tags.end();
                     tagIt != tagItEnd;
                     ++tagIt ) {
                 std::string tagName = *tagIt;
@@ -5465,6 +6840,50 @@ namespace Catch {
         return factories.size();
     }
 
+    // Each group is headed by a comment line, so that its names can be cut
+    // out and passed to another machine with --input-file
+    inline std::size_t listPartitions( Config const& config ) {
+        TestSpec testSpec = config.testSpec();
+        if( !config.testSpec().hasFilters() )
+            testSpec = TestSpecParser( ITagAliasRegistry::get() ).parse( "~[.]" ).testSpec();
+
+        TestDurations durations;
+        if( !config.durationsFile().empty() )
+            durations.load( config.durationsFile() );
+
+        std::vector<TestCase const*> matchedTestCases = filterTests( getAllTestCasesSorted( config ), testSpec, config );
+        std::size_t groups = static_cast<std::size_t>( config.partitions() );
+        std::vector<std::size_t> groupOf = balanceTests( matchedTestCases, groups, durations );
+
+        for( std::size_t group = 0; group < groups; ++group ) {
+            std::size_t count = 0;
+            uint64_t recordedNanoseconds = 0;
+            for( std::size_t i = 0; i < matchedTestCases.size(); ++i ) {
+                if( groupOf[i] == group ) {
+                    ++count;
+                    if( uint64_t const* duration = durations.find( matchedTestCases[i]->name ) )
+                        recordedNanoseconds += *duration;
+                }
+            }
+            Catch::cout() << "# Group " << group+1 << " of " << groups << ": " << pluralise( count, "test case" );
+            if( !durations.empty() )
+                Catch::cout() << ", " << durationToString( recordedNanoseconds ) << " s recorded";
+            Catch::cout() << "\n";
+
+            for( std::size_t i = 0; i < matchedTestCases.size(); ++i ) {
+                if( groupOf[i] != group )
+                    continue;
+                std::string const& name = matchedTestCases[i]->name;
+                if( startsWith( name, "#" ) )
+                   Catch::cout() << "\"" << name << "\"\n";
+                else
+                   Catch::cout() << name << "\n";
+            }
+        }
+        Catch::cout() << std::flush;
+        return matchedTestCases.size();
+    }
+
     inline Option<std::size_t> list( Config const& config ) {
         Option<std::size_t> listedCount;
         if( config.listTests() )
@@ -5475,6 +6894,8 @@ namespace Catch {
             listedCount = listedCount.valueOr(0) + listTags( config );
         if( config.listReporters() )
             listedCount = listedCount.valueOr(0) + listReporters( config );
+        if( config.partitions() > 0 )
+            listedCount = listedCount.valueOr(0) + listPartitions( config );
         return listedCount;
     }
 
@@ -5583,19 +7004,21 @@ namespace TestCaseTracking {
             CompletedSuccessfully,
             Failed
         };
-        class TrackerHasName {
-            std::string m_name;
-        public:
-            TrackerHasName( std::string const& name ) : m_name( name ) {}
-            bool operator ()( Ptr<ITracker> const& tracker ) {
-                return tracker->name() == m_name;
-            }
-        };
         typedef std::vector<Ptr<ITracker> > Children;
+        // Every SECTION is looked up again on every cycle of the test case,
+        // and sections generated in a loop can number thousands, so children
+        // are also kept in an open addressed table of indices into m_children,
+        // keyed by name hash, and names are only compared when hashes collide
+        struct ChildSlot {
+            uint64_t hash;
+            std::size_t child;
+        };
         std::string m_name;
         TrackerContext& m_ctx;
         ITracker* m_parent;
         Children m_children;
+        std::vector<std::string> m_childNames; // In the order of m_children
+        std::vector<ChildSlot> m_childSlots; // A power of two in size, or empty
         CycleState m_runState;
     public:
         TrackerBase( std::string const& name, TrackerContext& ctx, ITracker* parent )
@@ -5624,13 +7047,26 @@ namespace TestCaseTracking {
 
         virtual void addChild( Ptr<ITracker> const& child ) CATCH_OVERRIDE {
             m_children.push_back( child );
+            m_childNames.push_back( child->name() );
+            if( m_childNames.size() * 2 > m_childSlots.size() )
+                rehashChildren( (std::max)( m_childSlots.size() * 2, static_cast<std::size_t>( 16 ) ) );
+            else
+                insertChildSlot( hashChildName( m_childNames.back() ), m_childNames.size()-1 );
         }
 
         virtual ITracker* findChild( std::string const& name ) CATCH_OVERRIDE {
-            Children::const_iterator it = std::find_if( m_children.begin(), m_children.end(), TrackerHasName( name ) );
-            return( it != m_children.end() )
-                ? it->get()
-                : CATCH_NULL;
+            if( m_childSlots.empty() )
+                return CATCH_NULL;
+            uint64_t hash = hashChildName( name );
+            std::size_t const mask = m_childSlots.size()-1;
+            for( std::size_t slot = static_cast<std::size_t>( hash ) & mask;
+                    m_childSlots[slot].child != noChild;
+                    slot = ( slot+1 ) & mask ) {
+                ChildSlot const& candidate = m_childSlots[slot];
+                if( candidate.hash == hash && m_childNames[candidate.child] == name )
+                    return m_children[candidate.child].get();
+            }
+            return CATCH_NULL;
         }
         virtual ITracker& parent() CATCH_OVERRIDE {
             assert( m_parent ); // Should always be non-null except for root
@@ -5694,7 +7130,49 @@ namespace TestCaseTracking {
         virtual void markAsNeedingAnotherRun() CATCH_OVERRIDE {
             m_runState = NeedsAnotherRun;
         }
+    protected:
+        void clearChildren() {
+            m_children.clear();
+            m_childNames.clear();
+            m_childSlots.clear();
+        }
     private:
+        static std::size_t const noChild = static_cast<std::size_t>( -1 );
+
+        // A SECTION's tracker name ends with its file and line, so names are
+        // long and alike, and are hashed eight bytes at a time rather than
+        // one at a time as hashTestName does
+        static uint64_t hashChildName( std::string const& name ) {
+            uint64_t const multiplier = ( static_cast<uint64_t>( 0x9e3779b9 ) << 32 ) | 0x7f4a7c15;
+            uint64_t hash = name.size();
+            std::size_t i = 0;
+            for( ; i + 8 <= name.size(); i += 8 ) {
+                uint64_t chunk;
+                std::memcpy( &chunk, name.data() + i, 8 );
+                hash = ( hash ^ chunk ) * multiplier;
+                hash ^= hash >> 32;
+            }
+            uint64_t tail = 0;
+            std::memcpy( &tail, name.data() + i, name.size() - i );
+            hash = ( hash ^ tail ) * multiplier;
+            return hash ^ ( hash >> 32 );
+        }
+
+        void insertChildSlot( uint64_t hash, std::size_t child ) {
+            std::size_t const mask = m_childSlots.size()-1;
+            std::size_t slot = static_cast<std::size_t>( hash ) & mask;
+            while( m_childSlots[slot].child != noChild )
+                slot = ( slot+1 ) & mask;
+            m_childSlots[slot].hash = hash;
+            m_childSlots[slot].child = child;
+        }
+        void rehashChildren( std::size_t capacity ) {
+            ChildSlot const empty = { 0, noChild };
+            m_childSlots.assign( capacity, empty );
+            for( std::size_t i = 0; i < m_childNames.size(); ++i )
+                insertChildSlot( hashChildName( m_childNames[i] ), i );
+        }
+
         void moveToParent() {
             assert( m_parent );
             m_ctx.setCurrentTracker( m_parent );
@@ -5774,7 +7252,7 @@ namespace TestCaseTracking {
 
         void moveNext() {
             m_index++;
-            m_children.clear();
+            clearChildren();
         }
 
         virtual void close() CATCH_OVERRIDE {
@@ -5810,6 +7288,8 @@ namespace Catch {
         IContext& context = Catch::getCurrentContext();
         IResultCapture* resultCapture = context.getResultCapture();
         resultCapture->handleFatalErrorCondition( message );
+        flushBufferedOutput();
+        finishCompressedOutput();
 
 		if( Catch::alwaysTrue() ) // avoids "no return" warnings
             exit( exitCode );
@@ -5878,8 +7358,40 @@ namespace Catch {
 #include <set>
 #include <string>
 
+#ifdef CATCH_CONFIG_FD_CAPTURE
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <cstdio>
+#endif
+
 namespace Catch {
 
+    // With --capture-limit a test that writes more than the limit keeps only the
+    // start and the end of its output, so the reporter isn't left holding all of it
+    inline void appendCapturedOutput( std::string& target, char const* data, std::size_t size, std::size_t limit ) {
+        if( limit == 0 || size <= limit ) {
+            target.append( data, size );
+            return;
+        }
+        std::size_t head = limit / 2;
+        std::size_t tail = limit - head;
+        std::ostringstream omitted;
+        omitted << "\n... " << ( size - limit ) << " bytes of output omitted ...\n";
+        target.append( data, head );
+        target += omitted.str();
+        target.append( data + size - tail, tail );
+    }
+    inline void limitCapturedOutput( std::string& output, std::size_t limit ) {
+        if( limit != 0 && output.size() > limit ) {
+            std::string limited;
+            appendCapturedOutput( limited, output.data(), output.size(), limit );
+            output.swap( limited );
+        }
+    }
+
     class StreamRedirect {
 
     public:
@@ -5903,6 +7415,161 @@ namespace Catch {
         std::string& m_targetString;
     };
 
+#ifdef CATCH_CONFIG_FD_CAPTURE
+
+    // An unnamed file in memory, that a file descriptor can be pointed at
+    class CaptureFile {
+        CaptureFile( CaptureFile const& );
+        void operator =( CaptureFile const& );
+
+    public:
+        CaptureFile()
+        :   m_fd( -1 ),
+            m_file( CATCH_NULL )
+        {
+#ifdef SYS_memfd_create
+            m_fd = static_cast<int>( ::syscall( SYS_memfd_create, "catch-capture", 0x0001U /* MFD_CLOEXEC */ ) );
+#endif
+            // Kernels before 3.17 don't have memfd_create, but a temporary file does the same job
+            if( m_fd < 0 ) {
+                m_file = std::tmpfile();
+                if( !m_file )
+                    throw std::runtime_error( "Unable to create a file to capture output in" );
+                m_fd = fileno( m_file );
+            }
+        }
+        ~CaptureFile() {
+            if( m_file )
+                std::fclose( m_file );
+            else
+                ::close( m_fd );
+        }
+
+        int fd() const { return m_fd; }
+
+        // Appends everything written since the last clear(), mapping the file
+        // rather than reading it, so only what is kept gets copied
+        void appendTo( std::string& target, std::size_t limit ) {
+            struct stat info;
+            if( ::fstat( m_fd, &info ) != 0 || info.st_size <= 0 )
+                return;
+            std::size_t size = static_cast<std::size_t>( info.st_size );
+            void* mapped = ::mmap( CATCH_NULL, size, PROT_READ, MAP_SHARED, m_fd, 0 );
+            if( mapped != MAP_FAILED ) {
+                appendCapturedOutput( target, static_cast<char const*>( mapped ), size, limit );
+                ::munmap( mapped, size );
+            }
+            else {
+                std::string output( size, '\0' );
+                std::size_t read = 0;
+                while( read < size ) {
+                    ssize_t result = ::pread( m_fd, &output[read], size - read, static_cast<off_t>( read ) );
+                    if( result <= 0 )
+                        break;
+                    read += static_cast<std::size_t>( result );
+                }
+                appendCapturedOutput( target, output.data(), read, limit );
+            }
+        }
+        void clear() {
+            if( ::ftruncate( m_fd, 0 ) != 0 )
+                throw std::runtime_error( "Unable to reset captured output" );
+            ::lseek( m_fd, 0, SEEK_SET );
+        }
+
+    private:
+        int m_fd;
+        std::FILE* m_file;
+    };
+
+    // For --capture-fd: points stdout and stderr themselves at in-memory files
+    // while a test runs, so that printf, C libraries and child processes are
+    // captured as well as std::cout and std::cerr. The reporter's own output
+    // may be going to stdout too, so it is held back until the test is done
+    class FileDescriptorCapture {
+        FileDescriptorCapture( FileDescriptorCapture const& );
+        void operator =( FileDescriptorCapture const& );
+
+    public:
+        explicit FileDescriptorCapture( std::ostream& reporterStream )
+        :   m_reporterStream( reporterStream ),
+            m_reporterBuf( CATCH_NULL ),
+            m_savedStdOut( -1 ),
+            m_savedStdErr( -1 )
+        {}
+        ~FileDescriptorCapture() {
+            stop();
+        }
+
+        void start() {
+            m_reporterStream.flush();
+            m_reporterBuf = m_reporterStream.rdbuf( m_heldReporterOutput.rdbuf() );
+            m_savedStdOut = redirect( Catch::cout(), stdout, STDOUT_FILENO, m_stdOut.fd() );
+            m_savedStdErr = redirect( Catch::cerr(), stderr, STDERR_FILENO, m_stdErr.fd() );
+        }
+        // Safe to call when not capturing, as it is after a fatal error
+        void stop() {
+            if( !m_reporterBuf )
+                return;
+            restore( Catch::cout(), stdout, STDOUT_FILENO, m_savedStdOut );
+            restore( Catch::cerr(), stderr, STDERR_FILENO, m_savedStdErr );
+            m_reporterStream.rdbuf( m_reporterBuf );
+            m_reporterBuf = CATCH_NULL;
+            if( m_heldReporterOutput.tellp() > 0 ) {
+                m_reporterStream << m_heldReporterOutput.str();
+                m_heldReporterOutput.str( "" );
+            }
+        }
+
+        // Captures for as long as it is in scope
+        class Scope {
+            Scope( Scope const& );
+            void operator =( Scope const& );
+        public:
+            explicit Scope( FileDescriptorCapture& capture ) : m_capture( capture ) { m_capture.start(); }
+            ~Scope() { m_capture.stop(); }
+        private:
+            FileDescriptorCapture& m_capture;
+        };
+
+        // Takes everything captured since the last time
+        void takeOutput( std::string& stdOut, std::string& stdErr, std::size_t limit ) {
+            m_stdOut.appendTo( stdOut, limit );
+            m_stdErr.appendTo( stdErr, limit );
+            m_stdOut.clear();
+            m_stdErr.clear();
+        }
+
+    private:
+        static int redirect( std::ostream& stream, std::FILE* file, int fd, int captureFd ) {
+            stream.flush();
+            std::fflush( file );
+            int saved = ::dup( fd );
+            if( saved < 0 || ::dup2( captureFd, fd ) < 0 )
+                throw std::runtime_error( "Unable to capture output" );
+            return saved;
+        }
+        static void restore( std::ostream& stream, std::FILE* file, int fd, int& saved ) {
+            if( saved < 0 )
+                return;
+            stream.flush();
+            std::fflush( file );
+            ::dup2( saved, fd );
+            ::close( saved );
+            saved = -1;
+        }
+
+        std::ostream& m_reporterStream;
+        std::streambuf* m_reporterBuf;
+        std::ostringstream m_heldReporterOutput;
+        CaptureFile m_stdOut;
+        CaptureFile m_stdErr;
+        int m_savedStdOut;
+        int m_savedStdErr;
+    };
+
+#endif // CATCH_CONFIG_FD_CAPTURE
+
     ///////////////////////////////////////////////////////////////////////////
 
     class RunContext : public IResultCapture, public IRunner {
@@ -5916,12 +7583,22 @@ namespace Catch {
         :   m_runInfo( _config->name() ),
             m_context( getCurrentMutableContext() ),
             m_activeTestCase( CATCH_NULL ),
+            m_lastAssertionPassed( false ),
             m_config( _config ),
-            m_reporter( reporter )
+            m_reporter( reporter ),
+            m_reportPassingAssertions( _config->includeSuccessfulResults() || reporter->getPreferences().shouldReportAllAssertions )
         {
+            AssertionResultData passed;
+            passed.resultType = ResultWas::Ok;
+            m_passedResult = AssertionResult( AssertionInfo( "", SourceLineInfo(), "", ResultDisposition::Normal ), passed );
+
             m_context.setRunner( this );
             m_context.setConfig( m_config );
             m_context.setResultCapture( this );
+#ifdef CATCH_CONFIG_FD_CAPTURE
+            if( m_config->captureFileDescriptors() && m_reporter->getPreferences().shouldRedirectStdOut )
+                m_fdCapture.reset( new FileDescriptorCapture( m_config->stream() ) );
+#endif
             m_reporter->testRunStarting( m_runInfo );
         }
 
@@ -5948,6 +7625,8 @@ namespace Catch {
 
             m_activeTestCase = &testCase;
 
+            Timer timer( m_config->timerClock() );
+            timer.start();
             do {
                 m_trackerContext.startRun();
                 do {
@@ -5959,6 +7638,8 @@ namespace Catch {
             }
             // !TBD: deprecated - this will be replaced by indexed trackers
             while( getCurrentContext().advanceGeneratorsForCurrentTest() && !aborting() );
+            uint64_t duration = timer.getElapsedNanoseconds();
+            takeRedirectedOutput( redirectedCout, redirectedCerr );
 
             Totals deltaTotals = m_totals.delta( prevTotals );
             if( testInfo.expectedToFail() && deltaTotals.testCases.passed > 0 ) {
@@ -5971,7 +7652,9 @@ namespace Catch {
                                                         deltaTotals,
                                                         redirectedCout,
                                                         redirectedCerr,
-                                                        aborting() ) );
+                                                        aborting(),
+                                                        duration ) );
+            flushBufferedOutput();
 
             m_activeTestCase = CATCH_NULL;
             m_testCaseTracker = CATCH_NULL;
@@ -5993,12 +7676,24 @@ namespace Catch {
                 m_totals.assertions.failed++;
             }
 
-            if( m_reporter->assertionEnded( AssertionStats( result, m_messages, m_totals ) ) )
-                m_messages.clear();
+            if( m_reporter->assertionEnded( AssertionStats( result, formatMessages(), m_totals ) ) )
+                clearMessages();
 
             // Reset working state
-            m_lastAssertionInfo = AssertionInfo( "", m_lastAssertionInfo.lineInfo, "{Unknown expression after the reported line}" , m_lastAssertionInfo.resultDisposition );
+            resetAssertionInfo();
             m_lastResult = result;
+            m_lastAssertionPassed = false;
+        }
+
+        // Passing assertions that won't be reported are only counted: no
+        // result, stats or copy of the messages is made for them, so once the
+        // reused buffers have grown they make no heap allocations at all.
+        // Reporters and listeners are not told about them either, unless one
+        // asks to be through ReporterPreferences::shouldReportAllAssertions
+        virtual void assertionPassed() {
+            m_totals.assertions.passed++;
+            resetAssertionInfo();
+            m_lastAssertionPassed = true;
         }
 
         virtual bool sectionStarted (
@@ -6006,10 +7701,22 @@ namespace Catch {
             Counts& assertions
         )
         {
-            std::ostringstream oss;
-            oss << sectionInfo.name << "@" << sectionInfo.lineInfo;
+            // Built in place rather than streamed, as this runs for every
+            // SECTION met on every cycle, whether or not it is entered
+            std::string& trackerName = m_sectionTrackerName;
+            trackerName.assign( sectionInfo.name );
+            trackerName += '@';
+            trackerName += sectionInfo.lineInfo.file;
+#ifndef __GNUG__
+            trackerName += '(';
+            appendNumber( trackerName, sectionInfo.lineInfo.line );
+            trackerName += ')';
+#else
+            trackerName += ':';
+            appendNumber( trackerName, sectionInfo.lineInfo.line );
+#endif
 
-            ITracker& sectionTracker = SectionTracker::acquire( m_trackerContext, oss.str() );
+            ITracker& sectionTracker = SectionTracker::acquire( m_trackerContext, trackerName );
             if( !sectionTracker.isOpen() )
                 return false;
             m_activeSections.push_back( &sectionTracker );
@@ -6043,8 +7750,8 @@ namespace Catch {
                 m_activeSections.pop_back();
             }
 
-            m_reporter->sectionEnded( SectionStats( endInfo.sectionInfo, assertions, endInfo.durationInSeconds, missingAssertions ) );
-            m_messages.clear();
+            m_reporter->sectionEnded( SectionStats( endInfo.sectionInfo, assertions, endInfo.durationInNanoseconds, missingAssertions ) );
+            clearMessages();
         }
 
         virtual void sectionEndedEarly( SectionEndInfo const& endInfo ) {
@@ -6057,12 +7764,53 @@ namespace Catch {
             m_unfinishedSections.push_back( endInfo );
         }
 
-        virtual void pushScopedMessage( MessageInfo const& message ) {
+        virtual void pushScopedMessage( MessageInfo const& message, MessageArgs const& args ) {
             m_messages.push_back( message );
+            m_messageArgs.push_back( args );
+        }
+
+        virtual void popScopedMessage( MessageInfo const& message, MessageArgs const& args ) {
+            for( std::size_t i = m_messages.size(); i > 0; --i ) {
+                if( m_messages[i-1] == message ) {
+                    m_messages.erase( m_messages.begin() + static_cast<std::ptrdiff_t>( i-1 ) );
+                    m_messageArgs.erase( m_messageArgs.begin() + static_cast<std::ptrdiff_t>( i-1 ) );
+                    break;
+                }
+            }
+            // Messages go out of scope in the reverse of the order they were
+            // built in, so none of the values still held lie beyond this one's
+            m_messageArena.truncate( args.begin );
+        }
+
+        virtual MessageArena& messageArena() {
+            return m_messageArena;
         }
 
-        virtual void popScopedMessage( MessageInfo const& message ) {
-            m_messages.erase( std::remove( m_messages.begin(), m_messages.end(), message ), m_messages.end() );
+        virtual void benchmarkEnded( BenchmarkStats const& stats ) {
+            m_reporter->benchmarkEnded( stats );
+
+            BenchmarkBaseline const* baseline = m_config->benchmarkBaseline();
+            if( !baseline || !m_activeTestCase )
+                return;
+            std::vector<double> const* baselineSamples = baseline->find( m_activeTestCase->name, stats.info.name );
+            if( !baselineSamples )
+                return;
+
+            // Only a slowdown that is beyond the threshold across the whole
+            // confidence interval counts, so noise alone can't fail the run
+            BenchmarkComparison comparison = compareBenchmarkSamples( *baselineSamples, stats.samples );
+            double threshold = m_config->benchmarkRegressionThreshold();
+            if( comparison.lowerBound * 100 > threshold ) {
+                std::ostringstream oss;
+                oss << std::fixed << std::setprecision( 1 )
+                    << "Benchmark '" << stats.info.name << "' is " << comparison.change * 100
+                    << "% slower than its baseline (95% CI " << comparison.lowerBound * 100
+                    << "% to " << comparison.upperBound * 100 << "%, threshold " << threshold << "%)";
+                AssertionResultData data;
+                data.resultType = ResultWas::ExplicitFailure;
+                data.message = oss.str();
+                assertionEnded( AssertionResult( AssertionInfo( "BENCHMARK", stats.info.lineInfo, "", ResultDisposition::ContinueOnFailure ), data ) );
+            }
         }
 
         virtual std::string getCurrentTestName() const {
@@ -6072,10 +7820,19 @@ namespace Catch {
         }
 
         virtual const AssertionResult* getLastResult() const {
-            return &m_lastResult;
+            return m_lastAssertionPassed ? &m_passedResult : &m_lastResult;
+        }
+
+        virtual bool reportsPassingAssertions() const {
+            return m_reportPassingAssertions;
         }
 
         virtual void handleFatalErrorCondition( std::string const& message ) {
+#ifdef CATCH_CONFIG_FD_CAPTURE
+            // The report mustn't end up in the capture files
+            if( m_fdCapture.get() )
+                m_fdCapture->stop();
+#endif
             ResultBuilder resultBuilder = makeUnexpectedResultBuilder();
             resultBuilder.setResultType( ResultWas::FatalErrorCondition );
             resultBuilder << message;
@@ -6100,7 +7857,8 @@ namespace Catch {
                                                         deltaTotals,
                                                         "",
                                                         "",
-                                                        false ) );
+                                                        false,
+                                                        0 ) );
             m_totals.testCases.failed++;
             testGroupEnded( "", m_totals, 1, 1 );
             m_reporter->testRunEnded( TestRunStats( m_runInfo, m_totals, false ) );
@@ -6119,14 +7877,21 @@ namespace Catch {
             SectionInfo testCaseSection( testCaseInfo.lineInfo, testCaseInfo.name, testCaseInfo.description );
             m_reporter->sectionStarting( testCaseSection );
             Counts prevAssertions = m_totals.assertions;
-            double duration = 0;
+            uint64_t duration = 0;
             try {
                 m_lastAssertionInfo = AssertionInfo( "TEST_CASE", testCaseInfo.lineInfo, "", ResultDisposition::Normal );
 
                 seedRng( *m_config );
 
-                Timer timer;
+                Timer timer( m_config->timerClock() );
                 timer.start();
+#ifdef CATCH_CONFIG_FD_CAPTURE
+                if( m_fdCapture.get() ) {
+                    FileDescriptorCapture::Scope capturing( *m_fdCapture );
+                    invokeActiveTestCase();
+                }
+                else
+#endif
                 if( m_reporter->getPreferences().shouldRedirectStdOut ) {
                     StreamRedirect coutRedir( Catch::cout(), redirectedCout );
                     StreamRedirect cerrRedir( Catch::cerr(), redirectedCerr );
@@ -6135,7 +7900,7 @@ namespace Catch {
                 else {
                     invokeActiveTestCase();
                 }
-                duration = timer.getElapsedSeconds();
+                duration = timer.getElapsedNanoseconds();
             }
             catch( TestFailureException& ) {
                 // This just means the test was aborted due to failure
@@ -6145,7 +7910,8 @@ namespace Catch {
             }
             m_testCaseTracker->close();
             handleUnfinishedSections();
-            m_messages.clear();
+            clearMessages();
+            m_messageArena.truncate( 0 );
 
             Counts assertions = m_totals.assertions - prevAssertions;
             bool missingAssertions = testForMissingAssertions( assertions );
@@ -6160,6 +7926,18 @@ namespace Catch {
             m_reporter->sectionEnded( testCaseSectionStats );
         }
 
+        void takeRedirectedOutput( std::string& redirectedCout, std::string& redirectedCerr ) {
+            std::size_t limit = m_config->outputCaptureLimit();
+#ifdef CATCH_CONFIG_FD_CAPTURE
+            if( m_fdCapture.get() ) {
+                m_fdCapture->takeOutput( redirectedCout, redirectedCerr, limit );
+                return;
+            }
+#endif
+            limitCapturedOutput( redirectedCout, limit );
+            limitCapturedOutput( redirectedCerr, limit );
+        }
+
         void invokeActiveTestCase() {
             FatalConditionHandler fatalConditionHandler; // Handle signals
             m_activeTestCase->invoke();
@@ -6168,6 +7946,22 @@ namespace Catch {
 
     private:
 
+        static void appendNumber( std::string& str, std::size_t number ) {
+            char digits[24];
+            char* p = digits + sizeof( digits );
+            do {
+                *--p = static_cast<char>( '0' + number % 10 );
+                number /= 10;
+            } while( number != 0 );
+            str.append( p, digits + sizeof( digits ) );
+        }
+
+        void resetAssertionInfo() {
+            // Assigned in place, so the strings can reuse their storage
+            m_lastAssertionInfo.macroName = "";
+            m_lastAssertionInfo.capturedExpression = "{Unknown expression after the reported line}";
+        }
+
         ResultBuilder makeUnexpectedResultBuilder() const {
             return ResultBuilder(   m_lastAssertionInfo.macroName.c_str(),
                                     m_lastAssertionInfo.lineInfo,
@@ -6175,6 +7969,25 @@ namespace Catch {
                                     m_lastAssertionInfo.resultDisposition );
         }
 
+        // Messages are only formatted once an assertion is reported while they
+        // are in scope. What they held is a copy, so once is enough
+        std::vector<MessageInfo> const& formatMessages() {
+            for( std::size_t i = 0; i < m_messages.size(); ++i ) {
+                MessageArgs& args = m_messageArgs[i];
+                if( args.begin != args.end ) {
+                    std::ostringstream oss;
+                    m_messageArena.writeTo( oss, args.begin, args.end );
+                    m_messages[i].message = oss.str();
+                    args.end = args.begin;
+                }
+            }
+            return m_messages;
+        }
+        void clearMessages() {
+            m_messages.clear();
+            m_messageArgs.clear();
+        }
+
         void handleUnfinishedSections() {
             // If sections ended prematurely due to an exception we stored their
             // infos here so we can tear them down outside the unwind process.
@@ -6186,30 +7999,1509 @@ namespace Catch {
             m_unfinishedSections.clear();
         }
 
-        TestRunInfo m_runInfo;
-        IMutableContext& m_context;
-        TestCase const* m_activeTestCase;
-        ITracker* m_testCaseTracker;
-        ITracker* m_currentSectionTracker;
-        AssertionResult m_lastResult;
-
-        Ptr<IConfig const> m_config;
-        Totals m_totals;
+        TestRunInfo m_runInfo;
+        IMutableContext& m_context;
+        TestCase const* m_activeTestCase;
+        ITracker* m_testCaseTracker;
+        ITracker* m_currentSectionTracker;
+        AssertionResult m_lastResult;
+        AssertionResult m_passedResult;
+        bool m_lastAssertionPassed;
+
+        Ptr<IConfig const> m_config;
+        Totals m_totals;
+        Ptr<IStreamingReporter> m_reporter;
+        bool m_reportPassingAssertions;
+        std::vector<MessageInfo> m_messages;
+        std::vector<MessageArgs> m_messageArgs;
+        MessageArena m_messageArena;
+        AssertionInfo m_lastAssertionInfo;
+        std::vector<SectionEndInfo> m_unfinishedSections;
+        std::vector<ITracker*> m_activeSections;
+        TrackerContext m_trackerContext;
+        std::string m_sectionTrackerName;
+#ifdef CATCH_CONFIG_FD_CAPTURE
+        CATCH_AUTO_PTR( FileDescriptorCapture ) m_fdCapture;
+#endif
+    };
+
+    IResultCapture& getResultCapture() {
+        if( IResultCapture* capture = getCurrentContext().getResultCapture() )
+            return *capture;
+        else
+            throw std::logic_error( "No result capture instance" );
+    }
+
+} // end namespace Catch
+
+// #included from: catch_event_stream.hpp
+#define TWOBLUECUBES_CATCH_EVENT_STREAM_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <cstring>
+
+namespace Catch {
+
+    // Reporter events are flattened into length prefixed frames so they can
+    // be passed between processes and replayed into a real reporter later
+    struct EventKind { enum Type {
+        TestCaseStarting = 1,
+        SectionStarting,
+        AssertionEnded,
+        SectionEnded,
+        TestCaseEnded,
+        TestGroupEnded,
+        TestRunEnded,
+        StdOut,
+        StdErr,
+        BenchmarkEnded,
+        TestRunStarting,
+        TestGroupStarting,
+        NoMatchingTestCases,
+        SkipTest
+    }; };
+
+    // Strings that recur through a stream of events, such as file, class and
+    // macro names, can be written in full the first time and by index after
+    // that. The writer and the reader each build up their own copy
+    struct EventStringTable {
+        std::map<std::string, uint64_t> indices; // Used when writing
+        std::vector<std::string> strings;        // Used when reading
+    };
+
+    class EventWriter {
+    public:
+        explicit EventWriter( EventKind::Type kind, EventStringTable* strings = CATCH_NULL )
+        :   m_data( 4, '\0' ),
+            m_strings( strings )
+        {
+            writeInt( static_cast<uint64_t>( kind ) );
+        }
+
+        // Integers are written as base 128 varints, so small counts stay small
+        void writeInt( uint64_t value ) {
+            while( value >= 0x80 ) {
+                m_data += static_cast<char>( ( value & 0x7f ) | 0x80 );
+                value >>= 7;
+            }
+            m_data += static_cast<char>( value );
+        }
+        void writeBool( bool value ) {
+            m_data += value ? '\1' : '\0';
+        }
+        void writeDouble( double value ) {
+            uint64_t bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            writeInt( bits );
+        }
+        void writeString( std::string const& value ) {
+            writeInt( value.size() );
+            m_data += value;
+        }
+        // Without a string table this is the same as writeString. With one,
+        // an index one past the end of the table introduces a new string
+        void writeInternedString( std::string const& value ) {
+            if( !m_strings ) {
+                writeString( value );
+                return;
+            }
+            std::map<std::string, uint64_t>::const_iterator it = m_strings->indices.find( value );
+            if( it != m_strings->indices.end() )
+                writeInt( it->second );
+            else {
+                uint64_t index = m_strings->indices.size();
+                m_strings->indices.insert( std::make_pair( value, index ) );
+                writeInt( index );
+                writeString( value );
+            }
+        }
+
+        void write( SourceLineInfo const& lineInfo ) {
+            writeInternedString( lineInfo.file );
+            writeInt( lineInfo.line );
+        }
+        void write( Counts const& counts ) {
+            writeInt( counts.passed );
+            writeInt( counts.failed );
+            writeInt( counts.failedButOk );
+        }
+        void write( Totals const& totals ) {
+            write( totals.assertions );
+            write( totals.testCases );
+        }
+        void write( SectionInfo const& sectionInfo ) {
+            writeString( sectionInfo.name );
+            writeString( sectionInfo.description );
+            write( sectionInfo.lineInfo );
+        }
+        void write( MessageInfo const& message ) {
+            writeInternedString( message.macroName );
+            write( message.lineInfo );
+            writeInt( static_cast<uint64_t>( message.type ) );
+            writeString( message.message );
+            writeInt( message.sequence );
+        }
+        void write( AssertionResult const& result ) {
+            writeInternedString( result.m_info.macroName );
+            write( result.m_info.lineInfo );
+            writeString( result.m_info.capturedExpression );
+            writeInt( static_cast<uint64_t>( result.m_info.resultDisposition ) );
+            writeString( result.m_resultData.reconstructedExpression );
+            writeString( result.m_resultData.message );
+            writeInt( static_cast<uint64_t>( result.m_resultData.resultType ) );
+        }
+        // Only the raw samples are sent; the statistics are recomputed on replay
+        void write( BenchmarkStats const& stats ) {
+            writeString( stats.info.name );
+            write( stats.info.lineInfo );
+            writeInt( stats.iterationsPerSample );
+            writeInt( stats.samples.size() );
+            for( std::size_t i = 0; i < stats.samples.size(); ++i )
+                writeDouble( stats.samples[i] );
+        }
+        // Each test case starts or is skipped once, so its name isn't worth interning
+        void write( TestCaseInfo const& testInfo ) {
+            writeString( testInfo.name );
+            writeInternedString( testInfo.className );
+            writeString( testInfo.description );
+            writeInt( testInfo.tags.size() );
+            for( std::set<std::string>::const_iterator it = testInfo.tags.begin(), itEnd = testInfo.tags.end();
+                    it != itEnd;
+                    ++it )
+                writeInternedString( *it );
+            write( testInfo.lineInfo );
+        }
+
+        // Completes the length prefix and returns the whole frame
+        std::string const& frame() {
+            std::size_t size = m_data.size() - 4;
+            for( std::size_t i = 0; i < 4; ++i )
+                m_data[i] = static_cast<char>( ( size >> ( 8 * i ) ) & 0xff );
+            return m_data;
+        }
+
+    private:
+        std::string m_data;
+        EventStringTable* m_strings;
+    };
+
+    // SourceLineInfo only points at its file name, so names read back from
+    // events are interned to keep them alive for the rest of the run
+    inline char const* internFileName( std::string const& file ) {
+        static std::set<std::string> files;
+        return files.insert( file ).first->c_str();
+    }
+
+    class EventReader {
+    public:
+        // Returns the size of the frame at the start of data, or 0 if it is incomplete
+        static std::size_t frameSize( char const* data, std::size_t size ) {
+            if( size < 4 )
+                return 0;
+            std::size_t payload = 0;
+            for( std::size_t i = 0; i < 4; ++i )
+                payload |= static_cast<std::size_t>( static_cast<unsigned char>( data[i] ) ) << ( 8 * i );
+            return size < payload + 4 ? 0 : payload + 4;
+        }
+
+        EventReader( char const* frame, std::size_t size, EventStringTable* strings = CATCH_NULL )
+        :   m_pos( frame + 4 ),
+            m_end( frame + size ),
+            m_strings( strings ),
+            m_kind( static_cast<EventKind::Type>( readInt() ) )
+        {}
+
+        EventKind::Type kind() const { return m_kind; }
+
+        uint64_t readInt() {
+            uint64_t value = 0;
+            for( unsigned int shift = 0; ; shift += 7 ) {
+                if( m_pos == m_end || shift > 63 )
+                    throw std::runtime_error( "Truncated or corrupt reporter event" );
+                unsigned char byte = static_cast<unsigned char>( *m_pos++ );
+                value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+                if( ( byte & 0x80 ) == 0 )
+                    return value;
+            }
+        }
+        bool readBool() {
+            if( m_pos == m_end )
+                throw std::runtime_error( "Truncated or corrupt reporter event" );
+            return *m_pos++ != '\0';
+        }
+        double readDouble() {
+            uint64_t bits = readInt();
+            double value;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            return value;
+        }
+        std::string readString() {
+            std::size_t size = static_cast<std::size_t>( readInt() );
+            if( static_cast<std::size_t>( m_end - m_pos ) < size )
+                throw std::runtime_error( "Truncated or corrupt reporter event" );
+            std::string value( m_pos, size );
+            m_pos += size;
+            return value;
+        }
+        std::string readInternedString() {
+            if( !m_strings )
+                return readString();
+            uint64_t index = readInt();
+            if( index == m_strings->strings.size() )
+                m_strings->strings.push_back( readString() );
+            else if( index > m_strings->strings.size() )
+                throw std::runtime_error( "Truncated or corrupt reporter event" );
+            return m_strings->strings[static_cast<std::size_t>( index )];
+        }
+
+        SourceLineInfo readSourceLineInfo() {
+            char const* file = internFileName( readInternedString() );
+            std::size_t line = static_cast<std::size_t>( readInt() );
+            return SourceLineInfo( file, line );
+        }
+        Counts readCounts() {
+            Counts counts;
+            counts.passed = static_cast<std::size_t>( readInt() );
+            counts.failed = static_cast<std::size_t>( readInt() );
+            counts.failedButOk = static_cast<std::size_t>( readInt() );
+            return counts;
+        }
+        Totals readTotals() {
+            Totals totals;
+            totals.assertions = readCounts();
+            totals.testCases = readCounts();
+            return totals;
+        }
+        SectionInfo readSectionInfo() {
+            std::string name = readString();
+            std::string description = readString();
+            return SectionInfo( readSourceLineInfo(), name, description );
+        }
+        MessageInfo readMessageInfo() {
+            std::string macroName = readInternedString();
+            SourceLineInfo lineInfo = readSourceLineInfo();
+            MessageInfo message( macroName, lineInfo, static_cast<ResultWas::OfType>( readInt() ) );
+            message.message = readString();
+            message.sequence = static_cast<unsigned int>( readInt() );
+            return message;
+        }
+        AssertionResult readAssertionResult() {
+            std::string macroName = readInternedString();
+            SourceLineInfo lineInfo = readSourceLineInfo();
+            std::string capturedExpression = readString();
+            ResultDisposition::Flags resultDisposition = static_cast<ResultDisposition::Flags>( readInt() );
+            AssertionResultData data;
+            data.reconstructedExpression = readString();
+            data.message = readString();
+            data.resultType = static_cast<ResultWas::OfType>( readInt() );
+            return AssertionResult( AssertionInfo( macroName, lineInfo, capturedExpression, resultDisposition ), data );
+        }
+        BenchmarkStats readBenchmarkStats() {
+            std::string name = readString();
+            BenchmarkInfo info( name, readSourceLineInfo() );
+            uint64_t iterationsPerSample = readInt();
+            uint64_t sampleCount = readInt();
+            if( sampleCount > static_cast<uint64_t>( m_end - m_pos ) )
+                throw std::runtime_error( "Truncated or corrupt reporter event" );
+            std::vector<double> samples( static_cast<std::size_t>( sampleCount ) );
+            for( std::size_t i = 0; i < samples.size(); ++i )
+                samples[i] = readDouble();
+            return BenchmarkStats( info, iterationsPerSample, samples );
+        }
+        TestCaseInfo readTestCaseInfo() {
+            std::string name = readString();
+            std::string className = readInternedString();
+            std::string description = readString();
+            std::set<std::string> tags;
+            for( uint64_t count = readInt(); count > 0; --count ) {
+                if( m_pos == m_end )
+                    throw std::runtime_error( "Truncated or corrupt reporter event" );
+                tags.insert( readInternedString() );
+            }
+            return TestCaseInfo( name, className, description, tags, readSourceLineInfo() );
+        }
+
+    private:
+        char const* m_pos;
+        char const* m_end;
+        EventStringTable* m_strings;
+        EventKind::Type m_kind;
+    };
+
+    // Writes every reporter event out as a frame, for something else to read
+    // back and replay into a real reporter. Unless the real reporter captures
+    // the tests' console output itself, that is captured here and written out
+    // in StdOut and StdErr events, in order with the others
+    class EventStreamReporter : public SharedImpl<IStreamingReporter> {
+    public:
+        EventStreamReporter( ReporterPreferences const& preferences, EventStringTable* strings = CATCH_NULL )
+        :   m_preferences( preferences ),
+            m_strings( strings ),
+            m_prevCoutBuf( CATCH_NULL ),
+            m_prevCerrBuf( CATCH_NULL )
+        {}
+
+        virtual ReporterPreferences getPreferences() const CATCH_OVERRIDE {
+            return m_preferences;
+        }
+
+        virtual void noMatchingTestCases( std::string const& ) CATCH_OVERRIDE {}
+        virtual void testRunStarting( TestRunInfo const& ) CATCH_OVERRIDE {}
+        virtual void testGroupStarting( GroupInfo const& ) CATCH_OVERRIDE {}
+
+        virtual void testCaseStarting( TestCaseInfo const& ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestCaseStarting );
+            startTestCase( event );
+        }
+        virtual void sectionStarting( SectionInfo const& sectionInfo ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::SectionStarting );
+            event.write( sectionInfo );
+            send( event );
+        }
+
+        virtual void assertionStarting( AssertionInfo const& ) CATCH_OVERRIDE {}
+
+        virtual bool assertionEnded( AssertionStats const& assertionStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::AssertionEnded );
+            event.write( assertionStats.assertionResult );
+
+            // AssertionStats appends the result's own message, which will happen again on replay
+            std::size_t messageCount = assertionStats.infoMessages.size();
+            if( assertionStats.assertionResult.hasMessage() )
+                --messageCount;
+            event.writeInt( messageCount );
+            for( std::size_t i = 0; i < messageCount; ++i )
+                event.write( assertionStats.infoMessages[i] );
+
+            event.write( assertionStats.totals );
+            send( event );
+
+            // Only the real reporter knows whether the messages should be cleared,
+            // so keep them all and let the replay filter out the ones it cleared
+            return false;
+        }
+
+        virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::BenchmarkEnded );
+            event.write( benchmarkStats );
+            send( event );
+        }
+
+        virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::SectionEnded );
+            event.write( sectionStats.sectionInfo );
+            event.write( sectionStats.assertions );
+            event.writeInt( sectionStats.durationInNanoseconds );
+            event.writeBool( sectionStats.missingAssertions );
+            send( event );
+        }
+        virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestCaseEnded );
+            event.write( testCaseStats.totals );
+            event.writeString( testCaseStats.stdOut );
+            event.writeString( testCaseStats.stdErr );
+            event.writeBool( testCaseStats.aborting );
+            event.writeInt( testCaseStats.durationInNanoseconds );
+            send( event );
+
+            if( m_prevCoutBuf ) {
+                Catch::cout().rdbuf( m_prevCoutBuf );
+                Catch::cerr().rdbuf( m_prevCerrBuf );
+                m_prevCoutBuf = m_prevCerrBuf = CATCH_NULL;
+            }
+        }
+        virtual void testGroupEnded( TestGroupStats const& testGroupStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestGroupEnded );
+            event.writeString( testGroupStats.groupInfo.name );
+            event.writeInt( testGroupStats.groupInfo.groupIndex );
+            event.writeInt( testGroupStats.groupInfo.groupsCounts );
+            event.write( testGroupStats.totals );
+            event.writeBool( testGroupStats.aborting );
+            send( event );
+        }
+        virtual void testRunEnded( TestRunStats const& testRunStats ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestRunEnded );
+            event.write( testRunStats.totals );
+            event.writeBool( testRunStats.aborting );
+            send( event );
+        }
+
+        virtual void skipTest( TestCaseInfo const& ) CATCH_OVERRIDE {}
+
+    protected:
+        virtual void writeFrame( std::string const& frame ) = 0;
+
+        EventWriter newEvent( EventKind::Type kind ) {
+            return EventWriter( kind, m_strings );
+        }
+        // For console output captured some other way than by redirecting
+        // Catch::cout() and Catch::cerr(), which are then left alone. Whatever
+        // has been written since the last call goes to out and err, just
+        // before each event is sent
+        virtual bool capturesConsole() const { return false; }
+        virtual void takeConsoleOutput( std::ostream&, std::ostream& ) {}
+
+        void send( EventWriter& event ) {
+            takeConsoleOutput( m_cout, m_cerr );
+            sendOutput( EventKind::StdOut, m_cout );
+            sendOutput( EventKind::StdErr, m_cerr );
+            writeFrame( event.frame() );
+        }
+        void startTestCase( EventWriter& event ) {
+            // If the reporter doesn't capture output itself then the test's output
+            // is interleaved with the events, in the order it was written
+            if( !m_preferences.shouldRedirectStdOut && !capturesConsole() ) {
+                m_prevCoutBuf = Catch::cout().rdbuf( m_cout.rdbuf() );
+                m_prevCerrBuf = Catch::cerr().rdbuf( m_cerr.rdbuf() );
+            }
+            send( event );
+        }
+
+    private:
+        void sendOutput( EventKind::Type kind, std::ostringstream& oss ) {
+            // Checked without copying, as this comes before every event
+            if( oss.tellp() > 0 ) {
+                EventWriter event = newEvent( kind );
+                event.writeString( oss.str() );
+                writeFrame( event.frame() );
+                oss.str( "" );
+            }
+        }
+
+        ReporterPreferences m_preferences;
+        EventStringTable* m_strings;
+        std::ostringstream m_cout;
+        std::ostringstream m_cerr;
+        std::streambuf* m_prevCoutBuf;
+        std::streambuf* m_prevCerrBuf;
+    };
+
+} // end namespace Catch
+
+// #included from: catch_run_workers.hpp
+#define TWOBLUECUBES_CATCH_RUN_WORKERS_HPP_INCLUDED
+
+#ifdef CATCH_CONFIG_FORK
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <signal.h>
+#include <cstdio>
+#include <set>
+
+namespace Catch {
+
+    // Points a worker's stdout and stderr at temporary files for as long as it
+    // runs. Output written straight to the file descriptors, by printf or by a
+    // child process, is then forwarded in order with the events, as well as
+    // what goes through std::cout and std::cerr, rather than reaching the
+    // console ahead of the test that wrote it
+    class WorkerConsoleCapture : NonCopyable {
+        class Redirect : NonCopyable {
+        public:
+            explicit Redirect( int fd )
+            :   m_fd( fd ),
+                m_saved( -1 ),
+                m_file( std::tmpfile() ),
+                m_offset( 0 )
+            {
+                // Without a file the output goes straight out, as it always did
+                if( m_file ) {
+                    m_saved = ::dup( fd );
+                    if( m_saved < 0 || ::dup2( fileno( m_file ), fd ) < 0 )
+                        stop();
+                }
+            }
+
+            void takeOutput( std::ostream& os ) {
+                if( !m_file )
+                    return;
+                char chunk[4096];
+                ssize_t result;
+                while( ( result = ::pread( fileno( m_file ), chunk, sizeof( chunk ), static_cast<off_t>( m_offset ) ) ) > 0 ) {
+                    os.write( chunk, static_cast<std::streamsize>( result ) );
+                    m_offset += static_cast<std::size_t>( result );
+                }
+                // Start the file again rather than let it grow for the whole run
+                if( m_offset > 0 && ::ftruncate( m_fd, 0 ) == 0 ) {
+                    ::lseek( m_fd, 0, SEEK_SET );
+                    m_offset = 0;
+                }
+            }
+            void stop() {
+                if( !m_file )
+                    return;
+                if( m_saved >= 0 ) {
+                    std::ostringstream rest;
+                    takeOutput( rest );
+                    ::dup2( m_saved, m_fd );
+                    ::close( m_saved );
+                    std::string const& output = rest.str();
+                    for( std::size_t written = 0; written < output.size(); ) {
+                        ssize_t result = ::write( m_fd, output.data() + written, output.size() - written );
+                        if( result < 0 && errno != EINTR )
+                            break;
+                        if( result > 0 )
+                            written += static_cast<std::size_t>( result );
+                    }
+                }
+                std::fclose( m_file );
+                m_file = CATCH_NULL;
+            }
+
+        private:
+            int m_fd;
+            int m_saved;
+            std::FILE* m_file;
+            std::size_t m_offset;
+        };
+
+    public:
+        WorkerConsoleCapture()
+        :   m_stdOut( STDOUT_FILENO ),
+            m_stdErr( STDERR_FILENO )
+        {}
+
+        // Takes everything written since the last time
+        void takeOutput( std::ostream& out, std::ostream& err ) {
+            flush();
+            m_stdOut.takeOutput( out );
+            m_stdErr.takeOutput( err );
+        }
+        // Puts the console back, writing out anything that wasn't taken
+        void stop() {
+            flush();
+            m_stdOut.stop();
+            m_stdErr.stop();
+        }
+
+    private:
+        static void flush() {
+            flushBufferedOutput();
+            Catch::cout().flush();
+            Catch::cerr().flush();
+            std::fflush( stdout );
+            std::fflush( stderr );
+        }
+
+        Redirect m_stdOut;
+        Redirect m_stdErr;
+    };
+
+    // Stands in for the real reporter inside a worker process. Every event is
+    // written down a pipe, to be replayed into the real reporter by the parent
+    class EventForwardingReporter : public EventStreamReporter {
+    public:
+        EventForwardingReporter( int fd, ReporterPreferences const& preferences, WorkerConsoleCapture& console )
+        :   EventStreamReporter( preferences ),
+            m_fd( fd ),
+            m_console( console )
+        {}
+
+    private:
+        virtual bool capturesConsole() const CATCH_OVERRIDE {
+            return true;
+        }
+        virtual void takeConsoleOutput( std::ostream& out, std::ostream& err ) CATCH_OVERRIDE {
+            m_console.takeOutput( out, err );
+        }
+
+        virtual void writeFrame( std::string const& frame ) CATCH_OVERRIDE {
+            std::size_t written = 0;
+            while( written < frame.size() ) {
+                ssize_t result = ::write( m_fd, frame.data() + written, frame.size() - written );
+                if( result < 0 ) {
+                    if( errno == EINTR )
+                        continue;
+                    // The parent has gone away, so there is nobody left to report to
+                    _exit( EXIT_FAILURE );
+                }
+                written += static_cast<std::size_t>( result );
+            }
+        }
+
+        int m_fd;
+        WorkerConsoleCapture& m_console;
+    };
+
+    // Owns the worker processes and the read ends of their pipes. Any workers
+    // still running when it goes away are killed
+    class WorkerPool : NonCopyable {
+        struct Worker {
+            Worker( pid_t _pid, int _fd ) : pid( _pid ), fd( _fd ) {}
+            pid_t pid;
+            int fd;
+            std::string buffer;
+        };
+
+    public:
+        WorkerPool() {}
+        ~WorkerPool() {
+            killAll();
+        }
+
+        void add( pid_t pid, int fd ) {
+            m_workers.push_back( Worker( pid, fd ) );
+        }
+        std::size_t size() const {
+            return m_workers.size();
+        }
+        // Only meaningful in a newly forked worker, which must not hold the other pipes open
+        void closeAll() {
+            for( std::size_t i = 0; i < m_workers.size(); ++i )
+                if( m_workers[i].fd >= 0 )
+                    close( m_workers[i].fd );
+        }
+
+        // Waits for the next complete event from the given worker.
+        // Returns false if the worker closed its pipe first
+        bool nextEvent( std::size_t index, std::string& frame ) {
+            Worker& worker = m_workers[index];
+            for(;;) {
+                if( std::size_t size = EventReader::frameSize( worker.buffer.data(), worker.buffer.size() ) ) {
+                    frame.assign( worker.buffer, 0, size );
+                    worker.buffer.erase( 0, size );
+                    return true;
+                }
+                if( worker.fd < 0 )
+                    return false;
+                readAvailable();
+            }
+        }
+
+        // Reaps the worker and returns its exit code, or -1 if it didn't exit normally
+        int wait( std::size_t index ) {
+            Worker& worker = m_workers[index];
+            int status = 0;
+            while( waitpid( worker.pid, &status, 0 ) < 0 && errno == EINTR ) {}
+            worker.pid = -1;
+            return WIFEXITED( status ) ? WEXITSTATUS( status ) : -1;
+        }
+
+        void killAll() {
+            for( std::size_t i = 0; i < m_workers.size(); ++i ) {
+                Worker& worker = m_workers[i];
+                if( worker.fd >= 0 ) {
+                    close( worker.fd );
+                    worker.fd = -1;
+                }
+                if( worker.pid > 0 ) {
+                    kill( worker.pid, SIGKILL );
+                    wait( i );
+                }
+            }
+        }
+
+    private:
+        // Drains every worker that has something to say, so no worker stalls
+        // on a full pipe while we're waiting on another one
+        void readAvailable() {
+            std::vector<pollfd> fds;
+            std::vector<std::size_t> indices;
+            for( std::size_t i = 0; i < m_workers.size(); ++i ) {
+                if( m_workers[i].fd >= 0 ) {
+                    pollfd pfd;
+                    pfd.fd = m_workers[i].fd;
+                    pfd.events = POLLIN;
+                    pfd.revents = 0;
+                    fds.push_back( pfd );
+                    indices.push_back( i );
+                }
+            }
+            if( poll( &fds[0], fds.size(), -1 ) < 0 ) {
+                if( errno == EINTR )
+                    return;
+                throw std::runtime_error( "Unable to poll worker processes" );
+            }
+            char chunk[65536];
+            for( std::size_t i = 0; i < fds.size(); ++i ) {
+                if( fds[i].revents == 0 )
+                    continue;
+                Worker& worker = m_workers[indices[i]];
+                ssize_t result = read( worker.fd, chunk, sizeof( chunk ) );
+                if( result > 0 )
+                    worker.buffer.append( chunk, static_cast<std::size_t>( result ) );
+                else if( result == 0 || errno != EINTR ) {
+                    close( worker.fd );
+                    worker.fd = -1;
+                }
+            }
+        }
+
+        std::vector<Worker> m_workers;
+    };
+
+    // Runs the given test cases, in order, in a forked worker process, sending
+    // their events down fd, and never returns
+    inline void runWorker( Ptr<IConfig const> const& config,
+                           int fd,
+                           ReporterPreferences const& preferences,
+                           std::vector<TestCase const*> const& testCases ) {
+        int exitCode = 0;
+        WorkerConsoleCapture console;
+        try {
+            Ptr<IStreamingReporter> reporter = new EventForwardingReporter( fd, preferences, console );
+            for( std::size_t i = 0; i < testCases.size(); ++i ) {
+                // A fresh context per test case means all the totals that get sent
+                // are relative to the start of that test case
+                RunContext context( config, reporter );
+                context.runTest( *testCases[i] );
+            }
+            console.stop();
+        }
+        catch( std::exception& ex ) {
+            console.stop();
+            Catch::cerr() << ex.what() << std::endl;
+            exitCode = EXIT_FAILURE;
+        }
+        std::fflush( stdout );
+        _exit( exitCode );
+    }
+
+    // Spreads the matching test cases over a number of worker processes and
+    // replays their events into the reporter in the same order, and with the
+    // same totals, as a serial run would produce
+    class WorkerRunner {
+    public:
+        WorkerRunner( Ptr<IConfig const> const& config, Ptr<IStreamingReporter> const& reporter )
+        :   m_config( config ),
+            m_reporter( reporter ),
+            m_runInfo( config->name() )
+        {}
+
+        Totals run( TestSpec const& testSpec, std::size_t jobs ) {
+            std::vector<TestCase const*> const& allTestCases = getAllTestCasesSorted( *m_config );
+            std::vector<TestCase const*> matching = filterTests( allTestCases, testSpec, *m_config );
+
+            getCurrentMutableContext().setConfig( m_config );
+            m_reporter->testRunStarting( m_runInfo );
+            m_reporter->testGroupStarting( GroupInfo( m_config->name(), 1, 1 ) );
+
+            std::size_t workers = (std::min)( jobs, matching.size() );
+            std::vector<std::size_t> workerOf = assignWorkers( matching, workers );
+            startWorkers( matching, workerOf, workers );
+
+            Totals totals;
+            std::size_t matchIndex = 0;
+            for( std::size_t i = 0; i < allTestCases.size(); ++i ) {
+                if( matchIndex < matching.size() && matching[matchIndex] == allTestCases[i] ) {
+                    totals += replayTestCase( workerOf[matchIndex], *allTestCases[i] );
+                    flushBufferedOutput();
+                    ++matchIndex;
+                }
+                else
+                    m_reporter->skipTest( *allTestCases[i] );
+            }
+
+            m_reporter->testGroupEnded( TestGroupStats( GroupInfo( m_config->name(), 1, 1 ), totals, false ) );
+            m_reporter->testRunEnded( TestRunStats( m_runInfo, m_totals, false ) );
+            return totals;
+        }
+
+    private:
+        // Test cases are dealt out round robin unless there are durations to
+        // balance the workers by. Either way each worker runs its share in order
+        std::vector<std::size_t> assignWorkers( std::vector<TestCase const*> const& testCases, std::size_t count ) {
+            TestDurations durations;
+            if( !m_config->durationsFile().empty() )
+                durations.load( m_config->durationsFile() );
+            if( !durations.empty() )
+                return balanceTests( testCases, count, durations );
+
+            std::vector<std::size_t> workerOf( testCases.size() );
+            for( std::size_t i = 0; i < testCases.size(); ++i )
+                workerOf[i] = i % count;
+            return workerOf;
+        }
+
+        void startWorkers( std::vector<TestCase const*> const& testCases, std::vector<std::size_t> const& workerOf, std::size_t count ) {
+            // Anything still buffered would otherwise be written again by every worker
+            m_config->stream().flush();
+            flushBufferedOutput();
+            Catch::cout().flush();
+            Catch::cerr().flush();
+            std::fflush( CATCH_NULL );
+
+            for( std::size_t worker = 0; worker < count; ++worker ) {
+                std::vector<TestCase const*> share;
+                for( std::size_t i = 0; i < testCases.size(); ++i )
+                    if( workerOf[i] == worker )
+                        share.push_back( testCases[i] );
+
+                int fds[2];
+                if( pipe( fds ) != 0 )
+                    throw std::runtime_error( "Unable to create a pipe for a worker process" );
+                pid_t pid = fork();
+                if( pid < 0 ) {
+                    close( fds[0] );
+                    close( fds[1] );
+                    throw std::runtime_error( "Unable to fork a worker process" );
+                }
+                if( pid == 0 ) {
+                    close( fds[0] );
+                    m_workers.closeAll();
+                    runWorker( m_config, fds[1], m_reporter->getPreferences(), share );
+                }
+                close( fds[1] );
+                m_workers.add( pid, fds[0] );
+            }
+        }
+
+        Totals replayTestCase( std::size_t worker, TestCase const& testCase ) {
+            TestCaseInfo const& testInfo = testCase.getTestCaseInfo();
+            Totals deltaTotals;
+            bool fatal = false;
+            std::set<unsigned int> clearedMessages;
+
+            std::string frame;
+            for(;;) {
+                if( !m_workers.nextEvent( worker, frame ) )
+                    throw std::runtime_error( "Worker process terminated unexpectedly while running test case '" + testInfo.name + "'" );
+
+                EventReader event( frame.data(), frame.size() );
+                switch( event.kind() ) {
+                    case EventKind::StdOut:
+                        Catch::cout() << event.readString();
+                        break;
+                    case EventKind::StdErr:
+                        Catch::cerr() << event.readString();
+                        break;
+                    case EventKind::TestCaseStarting:
+                        m_reporter->testCaseStarting( testInfo );
+                        break;
+                    case EventKind::SectionStarting:
+                        m_reporter->sectionStarting( event.readSectionInfo() );
+                        break;
+                    case EventKind::AssertionEnded: {
+                        AssertionResult result = event.readAssertionResult();
+                        std::vector<MessageInfo> messages;
+                        for( std::size_t count = static_cast<std::size_t>( event.readInt() ); count > 0; --count ) {
+                            MessageInfo message = event.readMessageInfo();
+                            if( clearedMessages.find( message.sequence ) == clearedMessages.end() )
+                                messages.push_back( message );
+                        }
+                        Totals totals = m_totals;
+                        totals += event.readTotals();
+                        if( m_reporter->assertionEnded( AssertionStats( result, messages, totals ) ) ) {
+                            for( std::size_t i = 0; i < messages.size(); ++i )
+                                clearedMessages.insert( messages[i].sequence );
+                        }
+                        break;
+                    }
+                    case EventKind::BenchmarkEnded:
+                        m_reporter->benchmarkEnded( event.readBenchmarkStats() );
+                        break;
+                    case EventKind::SectionEnded: {
+                        SectionInfo sectionInfo = event.readSectionInfo();
+                        Counts assertions = event.readCounts();
+                        uint64_t durationInNanoseconds = event.readInt();
+                        bool missingAssertions = event.readBool();
+                        m_reporter->sectionEnded( SectionStats( sectionInfo, assertions, durationInNanoseconds, missingAssertions ) );
+                        break;
+                    }
+                    case EventKind::TestCaseEnded: {
+                        deltaTotals = event.readTotals();
+                        std::string stdOut = event.readString();
+                        std::string stdErr = event.readString();
+                        bool aborting = event.readBool();
+                        uint64_t durationInNanoseconds = event.readInt();
+                        m_reporter->testCaseEnded( TestCaseStats( testInfo, deltaTotals, stdOut, stdErr, aborting, durationInNanoseconds ) );
+                        break;
+                    }
+                    case EventKind::TestGroupEnded: {
+                        // Only sent when a fatal error condition ends the run early
+                        std::string name = event.readString();
+                        std::size_t groupIndex = static_cast<std::size_t>( event.readInt() );
+                        std::size_t groupsCount = static_cast<std::size_t>( event.readInt() );
+                        Totals totals = m_totals;
+                        totals += event.readTotals();
+                        bool aborting = event.readBool();
+                        m_reporter->testGroupEnded( TestGroupStats( GroupInfo( name, groupIndex, groupsCount ), totals, aborting ) );
+                        fatal = true;
+                        break;
+                    }
+                    case EventKind::TestRunEnded:
+                        m_totals += event.readTotals();
+                        if( fatal )
+                            abortRun( worker, event.readBool() );
+                        return deltaTotals;
+                    default:
+                        throw std::runtime_error( "Unrecognised event from worker process" );
+                }
+            }
+        }
+
+        // A worker hit a fatal error condition. Finish the report and exit
+        // with the worker's exit code, just as a serial run would have done
+        void abortRun( std::size_t worker, bool aborting ) {
+            m_reporter->testRunEnded( TestRunStats( m_runInfo, m_totals, aborting ) );
+            m_config->stream().flush();
+            flushBufferedOutput();
+            Catch::cout().flush();
+            Catch::cerr().flush();
+
+            std::string frame;
+            while( m_workers.nextEvent( worker, frame ) ) {}
+            int exitCode = m_workers.wait( worker );
+            m_workers.killAll();
+            exit( exitCode );
+        }
+
+        Ptr<IConfig const> m_config;
+        Ptr<IStreamingReporter> m_reporter;
+        TestRunInfo m_runInfo;
+        Totals m_totals; // Mirrors RunContext::m_totals of a serial run
+        WorkerPool m_workers;
+    };
+
+} // end namespace Catch
+
+#endif // CATCH_CONFIG_FORK
+
+// #included from: catch_benchmark_recorder.hpp
+#define TWOBLUECUBES_CATCH_BENCHMARK_RECORDER_HPP_INCLUDED
+
+namespace Catch {
+
+    // Listens for benchmark results and writes them all to a baseline file
+    // once the run is over. As a reporter it sees the results of --jobs
+    // workers too, which a RunContext would not
+    class BenchmarkRecorder : public SharedImpl<IStreamingReporter> {
+    public:
+        explicit BenchmarkRecorder( std::string const& filename )
+        :   m_filename( filename )
+        {}
+
+        virtual ReporterPreferences getPreferences() const CATCH_OVERRIDE {
+            return ReporterPreferences();
+        }
+
+        virtual void noMatchingTestCases( std::string const& ) CATCH_OVERRIDE {}
+        virtual void testRunStarting( TestRunInfo const& ) CATCH_OVERRIDE {}
+        virtual void testGroupStarting( GroupInfo const& ) CATCH_OVERRIDE {}
+
+        virtual void testCaseStarting( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
+            m_testName = testInfo.name;
+        }
+        virtual void sectionStarting( SectionInfo const& ) CATCH_OVERRIDE {}
+
+        virtual void assertionStarting( AssertionInfo const& ) CATCH_OVERRIDE {}
+        virtual bool assertionEnded( AssertionStats const& ) CATCH_OVERRIDE {
+            return false;
+        }
+
+        virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+            m_baseline.add( m_testName, benchmarkStats );
+        }
+
+        virtual void sectionEnded( SectionStats const& ) CATCH_OVERRIDE {}
+        virtual void testCaseEnded( TestCaseStats const& ) CATCH_OVERRIDE {}
+        virtual void testGroupEnded( TestGroupStats const& ) CATCH_OVERRIDE {}
+        virtual void testRunEnded( TestRunStats const& ) CATCH_OVERRIDE {
+            // This runs as the RunContext is destroyed, so mustn't throw
+            try {
+                m_baseline.save( m_filename );
+            }
+            catch( std::exception& ex ) {
+                Catch::cerr() << ex.what() << std::endl;
+            }
+        }
+
+        virtual void skipTest( TestCaseInfo const& ) CATCH_OVERRIDE {}
+
+    private:
+        std::string m_filename;
+        std::string m_testName;
+        BenchmarkBaseline m_baseline;
+    };
+
+} // end namespace Catch
+
+// #included from: catch_duration_recorder.hpp
+#define TWOBLUECUBES_CATCH_DURATION_RECORDER_HPP_INCLUDED
+
+namespace Catch {
+
+    // Adds up how long the outermost section of each test case took, over
+    // however many times it ran to get through its sections, and merges the
+    // totals into the --durations-file once the run is over
+    class DurationRecorder : public SharedImpl<IStreamingReporter> {
+    public:
+        explicit DurationRecorder( std::string const& filename )
+        :   m_filename( filename ),
+            m_sectionDepth( 0 ),
+            m_testDuration( 0 )
+        {}
+
+        virtual ReporterPreferences getPreferences() const CATCH_OVERRIDE {
+            return ReporterPreferences();
+        }
+
+        virtual void noMatchingTestCases( std::string const& ) CATCH_OVERRIDE {}
+        virtual void testRunStarting( TestRunInfo const& ) CATCH_OVERRIDE {}
+        virtual void testGroupStarting( GroupInfo const& ) CATCH_OVERRIDE {}
+
+        virtual void testCaseStarting( TestCaseInfo const& ) CATCH_OVERRIDE {
+            m_sectionDepth = 0;
+            m_testDuration = 0;
+        }
+        virtual void sectionStarting( SectionInfo const& ) CATCH_OVERRIDE {
+            ++m_sectionDepth;
+        }
+
+        virtual void assertionStarting( AssertionInfo const& ) CATCH_OVERRIDE {}
+        virtual bool assertionEnded( AssertionStats const& ) CATCH_OVERRIDE {
+            return false;
+        }
+
+        virtual void benchmarkEnded( BenchmarkStats const& ) CATCH_OVERRIDE {}
+
+        virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
+            if( --m_sectionDepth == 0 )
+                m_testDuration += sectionStats.durationInNanoseconds;
+        }
+        virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
+            m_durations.set( testCaseStats.testInfo.name, m_testDuration );
+        }
+        virtual void testGroupEnded( TestGroupStats const& ) CATCH_OVERRIDE {}
+        virtual void testRunEnded( TestRunStats const& ) CATCH_OVERRIDE {
+            // This runs as the RunContext is destroyed, so mustn't throw
+            try {
+                TestDurations merged;
+                merged.load( m_filename );
+                merged.merge( m_durations );
+                merged.save( m_filename );
+            }
+            catch( std::exception& ex ) {
+                Catch::cerr() << ex.what() << std::endl;
+            }
+        }
+
+        virtual void skipTest( TestCaseInfo const& ) CATCH_OVERRIDE {}
+
+    private:
+        std::string m_filename;
+        int m_sectionDepth;
+        uint64_t m_testDuration;
+        TestDurations m_durations;
+    };
+
+} // end namespace Catch
+
+// #included from: catch_reporter_async.hpp
+#define TWOBLUECUBES_CATCH_REPORTER_ASYNC_HPP_INCLUDED
+
+#ifdef CATCH_CONFIG_CPP11_THREADS
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <deque>
+#include <set>
+
+namespace Catch {
+
+    // For --async-reporter: copies each event into a bounded queue, for the
+    // real reporter to work through on a thread of its own, so that slow
+    // output doesn't hold up the tests. The queue is drained, and the thread
+    // finished with, before testRunEnded returns - which is also how a run
+    // that stops on a fatal signal gets its report out before exiting
+    class AsyncReporter : public SharedImpl<IStreamingReporter> {
+
+        struct Event {
+            virtual ~Event() {}
+            virtual void deliver( AsyncReporter& async ) = 0;
+        };
+
+        template<typename T>
+        class EventFor : public Event {
+        public:
+            typedef void (IStreamingReporter::*Callback)( T const& );
+
+            EventFor( Callback callback, T const& argument )
+            :   m_callback( callback ),
+                m_argument( argument )
+            {}
+            virtual void deliver( AsyncReporter& async ) CATCH_OVERRIDE {
+                ( ( *async.m_reporter ).*m_callback )( m_argument );
+            }
+
+        private:
+            Callback m_callback;
+            T m_argument;
+        };
+
+        class AssertionEndedEvent : public Event {
+        public:
+            explicit AssertionEndedEvent( AssertionStats const& assertionStats )
+            :   m_assertionStats( assertionStats )
+            {}
+            virtual void deliver( AsyncReporter& async ) CATCH_OVERRIDE {
+                async.assertionEndedNow( m_assertionStats );
+            }
+
+        private:
+            AssertionStats m_assertionStats;
+        };
+
+    public:
+        explicit AsyncReporter( Ptr<IStreamingReporter> const& reporter, std::size_t capacity = 1024 )
+        :   m_reporter( reporter ),
+            m_preferences( reporter->getPreferences() ),
+            m_capacity( capacity ),
+            m_finished( false ),
+            m_reporterFailed( false )
+        {
+            try {
+                m_thread = std::thread( &AsyncReporter::deliverEvents, this );
+            }
+            catch( std::system_error& ) {
+                // No threads to be had (e.g. built without -pthread), so report as we go
+            }
+        }
+        virtual ~AsyncReporter() {
+            finish();
+        }
+
+        virtual ReporterPreferences getPreferences() const CATCH_OVERRIDE {
+            return m_preferences;
+        }
+
+        virtual void noMatchingTestCases( std::string const& spec ) CATCH_OVERRIDE {
+            post( new EventFor<std::string>( &IStreamingReporter::noMatchingTestCases, spec ) );
+        }
+        virtual void testRunStarting( TestRunInfo const& testRunInfo ) CATCH_OVERRIDE {
+            post( new EventFor<TestRunInfo>( &IStreamingReporter::testRunStarting, testRunInfo ) );
+        }
+        virtual void testGroupStarting( GroupInfo const& groupInfo ) CATCH_OVERRIDE {
+            post( new EventFor<GroupInfo>( &IStreamingReporter::testGroupStarting, groupInfo ) );
+        }
+        virtual void testCaseStarting( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
+            post( new EventFor<TestCaseInfo>( &IStreamingReporter::testCaseStarting, testInfo ) );
+        }
+        virtual void sectionStarting( SectionInfo const& sectionInfo ) CATCH_OVERRIDE {
+            post( new EventFor<SectionInfo>( &IStreamingReporter::sectionStarting, sectionInfo ) );
+        }
+        virtual void assertionStarting( AssertionInfo const& assertionInfo ) CATCH_OVERRIDE {
+            post( new EventFor<AssertionInfo>( &IStreamingReporter::assertionStarting, assertionInfo ) );
+        }
+
+        virtual bool assertionEnded( AssertionStats const& assertionStats ) CATCH_OVERRIDE {
+            post( new AssertionEndedEvent( assertionStats ) );
+
+            // Only the real reporter knows whether the messages should be cleared,
+            // and it hasn't seen them yet, so keep them all and filter out the ones
+            // it cleared as they are delivered
+            return false;
+        }
+
+        virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+            post( new EventFor<BenchmarkStats>( &IStreamingReporter::benchmarkEnded, benchmarkStats ) );
+        }
+        virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
+            post( new EventFor<SectionStats>( &IStreamingReporter::sectionEnded, sectionStats ) );
+        }
+        virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
+            post( new EventFor<TestCaseStats>( &IStreamingReporter::testCaseEnded, testCaseStats ) );
+        }
+        virtual void testGroupEnded( TestGroupStats const& testGroupStats ) CATCH_OVERRIDE {
+            post( new EventFor<TestGroupStats>( &IStreamingReporter::testGroupEnded, testGroupStats ) );
+        }
+        virtual void testRunEnded( TestRunStats const& testRunStats ) CATCH_OVERRIDE {
+            post( new EventFor<TestRunStats>( &IStreamingReporter::testRunEnded, testRunStats ) );
+            finish();
+            rethrowError();
+        }
+
+        virtual void skipTest( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
+            post( new EventFor<TestCaseInfo>( &IStreamingReporter::skipTest, testInfo ) );
+        }
+
+    private:
+        void post( Event* event ) {
+            CATCH_AUTO_PTR( Event ) owned( event );
+            // Once the thread has gone - or if this is it, reporting a fatal
+            // signal from inside the real reporter - events are delivered in place
+            if( !m_thread.joinable() || std::this_thread::get_id() == m_thread.get_id() ) {
+                rethrowError();
+                owned->deliver( *this );
+                return;
+            }
+            std::unique_lock<std::mutex> lock( m_mutex );
+            while( m_events.size() >= m_capacity )
+                m_spaceAvailable.wait( lock );
+            m_events.push_back( owned.release() );
+            m_eventsAvailable.notify_one();
+            lock.unlock();
+            rethrowError();
+        }
+
+        // Waits for everything queued so far to be delivered, then lets the thread go
+        void finish() {
+            if( m_thread.joinable() && std::this_thread::get_id() != m_thread.get_id() ) {
+                {
+                    std::lock_guard<std::mutex> lock( m_mutex );
+                    m_finished = true;
+                }
+                m_eventsAvailable.notify_one();
+                m_thread.join();
+            }
+        }
+
+        void deliverEvents() {
+            for(;;) {
+                std::unique_lock<std::mutex> lock( m_mutex );
+                while( m_events.empty() && !m_finished )
+                    m_eventsAvailable.wait( lock );
+                if( m_events.empty() )
+                    return;
+                CATCH_AUTO_PTR( Event ) event( m_events.front() );
+                m_events.pop_front();
+                m_spaceAvailable.notify_one();
+                lock.unlock();
+
+                // After the reporter has thrown once, the rest of the events are dropped
+                if( !m_reporterFailed ) {
+                    try {
+                        event->deliver( *this );
+                    }
+                    catch( ... ) {
+                        m_reporterFailed = true;
+                        std::lock_guard<std::mutex> errorLock( m_mutex );
+                        m_error = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        // Exceptions from the real reporter surface on the test thread, at the next event
+        void rethrowError() {
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                std::swap( error, m_error );
+            }
+            if( error )
+                std::rethrow_exception( error );
+        }
+
+        void assertionEndedNow( AssertionStats& assertionStats ) {
+            std::vector<MessageInfo>& messages = assertionStats.infoMessages;
+            std::size_t kept = 0;
+            for( std::size_t i = 0; i < messages.size(); ++i ) {
+                if( m_clearedMessages.find( messages[i].sequence ) == m_clearedMessages.end() )
+                    messages[kept++] = messages[i];
+            }
+            messages.erase( messages.begin() + static_cast<std::ptrdiff_t>( kept ), messages.end() );
+            if( m_reporter->assertionEnded( assertionStats ) ) {
+                for( std::size_t i = 0; i < messages.size(); ++i )
+                    m_clearedMessages.insert( messages[i].sequence );
+            }
+        }
+
+        Ptr<IStreamingReporter> m_reporter;
+        ReporterPreferences m_preferences;
+        std::size_t m_capacity;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_eventsAvailable;
+        std::condition_variable m_spaceAvailable;
+        std::deque<Event*> m_events;
+        bool m_finished;
+        std::exception_ptr m_error;
+
+        // Only touched by whichever thread is delivering
+        bool m_reporterFailed;
+        std::set<unsigned int> m_clearedMessages;
+    };
+
+} // end namespace Catch
+
+#endif // CATCH_CONFIG_CPP11_THREADS
+
+// #included from: catch_event_log.hpp
+#define TWOBLUECUBES_CATCH_EVENT_LOG_HPP_INCLUDED
+
+#include <fstream>
+#include <set>
+
+namespace Catch {
+
+    namespace {
+        // An event log is this line followed by a frame for each event, as
+        // the eventlog reporter wrote them
+        char const* const eventLogHeader = "catch-event-log 1\n";
+    }
+
+    // Reads an event log back into a reporter, as though the reporter had
+    // been there for the run that wrote it
+    class EventLogReplayer {
+    public:
+        explicit EventLogReplayer( Ptr<IStreamingReporter> const& reporter )
+        :   m_reporter( reporter ),
+            m_redirectOutput( reporter->getPreferences().shouldRedirectStdOut ),
+            m_runEnded( false )
+        {}
+
+        Totals replay( std::string const& filename ) {
+            std::ifstream in( filename.c_str(), std::ios_base::in | std::ios_base::binary );
+            if( !in )
+                throw std::domain_error( "Unable to open event log: '" + filename + "'" );
+            std::string header( std::strlen( eventLogHeader ), '\0' );
+            if( !in.read( &header[0], static_cast<std::streamsize>( header.size() ) ) || header != eventLogHeader )
+                throw std::domain_error( "Not an event log: '" + filename + "'" );
+
+            std::string frame;
+            while( readFrame( in, frame ) ) {
+                EventReader event( frame.data(), frame.size(), &m_strings );
+                replayEvent( event );
+            }
+            if( !m_runEnded )
+                throw std::domain_error( "Event log '" + filename + "' ends before the end of the run" );
+            return m_totals;
+        }
+
+    private:
+        static bool readFrame( std::istream& in, std::string& frame ) {
+            frame.resize( 4 );
+            if( !in.read( &frame[0], 4 ) ) {
+                if( in.gcount() == 0 )
+                    return false;
+                throw std::domain_error( "Event log ends part way through an event" );
+            }
+            std::size_t payload = 0;
+            for( std::size_t i = 0; i < 4; ++i )
+                payload |= static_cast<std::size_t>( static_cast<unsigned char>( frame[i] ) ) << ( 8 * i );
+            frame.resize( 4 + payload );
+            if( payload > 0 && !in.read( &frame[4], static_cast<std::streamsize>( payload ) ) )
+                throw std::domain_error( "Event log ends part way through an event" );
+            return true;
+        }
+
+        TestCaseInfo const& currentTestCase() const {
+            if( !m_testInfo )
+                throw std::domain_error( "Event log has a test case event outside of a test case" );
+            return *m_testInfo;
+        }
+
+        void replayEvent( EventReader& event ) {
+            switch( event.kind() ) {
+                case EventKind::TestRunStarting:
+                    m_runName = event.readString();
+                    m_reporter->testRunStarting( TestRunInfo( m_runName ) );
+                    break;
+                case EventKind::TestGroupStarting: {
+                    std::string name = event.readString();
+                    std::size_t groupIndex = static_cast<std::size_t>( event.readInt() );
+                    std::size_t groupsCount = static_cast<std::size_t>( event.readInt() );
+                    m_reporter->testGroupStarting( GroupInfo( name, groupIndex, groupsCount ) );
+                    break;
+                }
+                case EventKind::NoMatchingTestCases:
+                    m_reporter->noMatchingTestCases( event.readString() );
+                    break;
+                case EventKind::SkipTest:
+                    m_reporter->skipTest( event.readTestCaseInfo() );
+                    break;
+                case EventKind::StdOut:
+                    if( m_redirectOutput )
+                        m_stdOut += event.readString();
+                    else
+                        Catch::cout() << event.readString();
+                    break;
+                case EventKind::StdErr:
+                    if( m_redirectOutput )
+                        m_stdErr += event.readString();
+                    else
+                        Catch::cerr() << event.readString();
+                    break;
+                case EventKind::TestCaseStarting:
+                    m_testInfo = event.readTestCaseInfo();
+                    m_clearedMessages.clear();
+                    m_stdOut.clear();
+                    m_stdErr.clear();
+                    m_reporter->testCaseStarting( *m_testInfo );
+                    break;
+                case EventKind::SectionStarting:
+                    m_reporter->sectionStarting( event.readSectionInfo() );
+                    break;
+                case EventKind::AssertionEnded: {
+                    AssertionResult result = event.readAssertionResult();
+                    std::vector<MessageInfo> messages;
+                    for( std::size_t count = static_cast<std::size_t>( event.readInt() ); count > 0; --count ) {
+                        MessageInfo message = event.readMessageInfo();
+                        if( m_clearedMessages.find( message.sequence ) == m_clearedMessages.end() )
+                            messages.push_back( message );
+                    }
+                    Totals totals = event.readTotals();
+                    if( m_reporter->assertionEnded( AssertionStats( result, messages, totals ) ) ) {
+                        for( std::size_t i = 0; i < messages.size(); ++i )
+                            m_clearedMessages.insert( messages[i].sequence );
+                    }
+                    break;
+                }
+                case EventKind::BenchmarkEnded:
+                    m_reporter->benchmarkEnded( event.readBenchmarkStats() );
+                    break;
+                case EventKind::SectionEnded: {
+                    SectionInfo sectionInfo = event.readSectionInfo();
+                    Counts assertions = event.readCounts();
+                    uint64_t durationInNanoseconds = event.readInt();
+                    bool missingAssertions = event.readBool();
+                    m_reporter->sectionEnded( SectionStats( sectionInfo, assertions, durationInNanoseconds, missingAssertions ) );
+                    break;
+                }
+                case EventKind::TestCaseEnded: {
+                    Totals totals = event.readTotals();
+                    std::string stdOut = m_stdOut + event.readString();
+                    std::string stdErr = m_stdErr + event.readString();
+                    bool aborting = event.readBool();
+                    uint64_t durationInNanoseconds = event.readInt();
+                    m_reporter->testCaseEnded( TestCaseStats( currentTestCase(), totals, stdOut, stdErr, aborting, durationInNanoseconds ) );
+                    m_testInfo.reset();
+                    break;
+                }
+                case EventKind::TestGroupEnded: {
+                    std::string name = event.readString();
+                    std::size_t groupIndex = static_cast<std::size_t>( event.readInt() );
+                    std::size_t groupsCount = static_cast<std::size_t>( event.readInt() );
+                    Totals totals = event.readTotals();
+                    bool aborting = event.readBool();
+                    m_reporter->testGroupEnded( TestGroupStats( GroupInfo( name, groupIndex, groupsCount ), totals, aborting ) );
+                    break;
+                }
+                case EventKind::TestRunEnded: {
+                    m_totals = event.readTotals();
+                    bool aborting = event.readBool();
+                    m_reporter->testRunEnded( TestRunStats( TestRunInfo( m_runName ), m_totals, aborting ) );
+                    m_runEnded = true;
+                    break;
+                }
+                default:
+                    throw std::domain_error( "Unrecognised event in event log" );
+            }
+        }
+
         Ptr<IStreamingReporter> m_reporter;
-        std::vector<MessageInfo> m_messages;
-        AssertionInfo m_lastAssertionInfo;
-        std::vector<SectionEndInfo> m_unfinishedSections;
-        std::vector<ITracker*> m_activeSections;
-        TrackerContext m_trackerContext;
+        bool m_redirectOutput;
+        bool m_runEnded;
+        EventStringTable m_strings;
+        std::string m_runName;
+        Option<TestCaseInfo> m_testInfo;
+        std::set<unsigned int> m_clearedMessages;
+        std::string m_stdOut;
+        std::string m_stdErr;
+        Totals m_totals;
     };
 
-    IResultCapture& getResultCapture() {
-        if( IResultCapture* capture = getCurrentContext().getResultCapture() )
-            return *capture;
-        else
-            throw std::logic_error( "No result capture instance" );
-    }
-
 } // end namespace Catch
 
 // #included from: internal/catch_version.h
@@ -6285,6 +9577,29 @@ namespace Catch {
 
         Ptr<IStreamingReporter> reporter = makeReporter( config );
         reporter = addListeners( iconfig, reporter );
+        if( !config->benchmarkSaveFile().empty() )
+            reporter = addReporter( reporter, new BenchmarkRecorder( config->benchmarkSaveFile() ) );
+        if( !config->durationsFile().empty() )
+            reporter = addReporter( reporter, new DurationRecorder( config->durationsFile() ) );
+
+        TestSpec testSpec = config->testSpec();
+        if( !testSpec.hasFilters() )
+            testSpec = TestSpecParser( ITagAliasRegistry::get() ).parse( "~[.]" ).testSpec(); // All not hidden tests
+
+#ifdef CATCH_CONFIG_FORK
+        // Where to stop after x failures depends on the serial order, so those runs stay in-process
+        if( config->jobs() > 1 && config->abortAfter() < 0 )
+            return WorkerRunner( iconfig, reporter ).run( testSpec, static_cast<std::size_t>( config->jobs() ) );
+#endif
+
+#ifdef CATCH_CONFIG_CPP11_THREADS
+        // With --jobs the tests are already kept apart from the reporter, and
+        // forking with another thread running is asking for trouble. Reporters
+        // that leave the tests' output alone write in among it, so have to keep
+        // in step with the tests - as do all of them under --capture-fd
+        if( config->asyncReporter() && reporter->getPreferences().shouldRedirectStdOut && !iconfig->captureFileDescriptors() )
+            reporter = new AsyncReporter( reporter );
+#endif
 
         RunContext context( iconfig, reporter );
 
@@ -6292,28 +9607,35 @@ namespace Catch {
 
         context.testGroupStarting( config->name(), 1, 1 );
 
-        TestSpec testSpec = config->testSpec();
-        if( !testSpec.hasFilters() )
-            testSpec = TestSpecParser( ITagAliasRegistry::get() ).parse( "~[.]" ).testSpec(); // All not hidden tests
-
-        std::vector<TestCase> const& allTestCases = getAllTestCasesSorted( *iconfig );
-        for( std::vector<TestCase>::const_iterator it = allTestCases.begin(), itEnd = allTestCases.end();
+        std::vector<TestCase const*> const& allTestCases = getAllTestCasesSorted( *iconfig );
+        std::vector<TestCase const*> matching = filterTests( allTestCases, testSpec, *iconfig );
+        std::vector<TestCase const*>::const_iterator nextMatch = matching.begin();
+        for( std::vector<TestCase const*>::const_iterator it = allTestCases.begin(), itEnd = allTestCases.end();
                 it != itEnd;
                 ++it ) {
-            if( !context.aborting() && matchTest( *it, testSpec, *iconfig ) )
-                totals += context.runTest( *it );
+            bool matched = nextMatch != matching.end() && *nextMatch == *it;
+            if( matched )
+                ++nextMatch;
+            if( !context.aborting() && matched )
+                totals += context.runTest( **it );
             else
-                reporter->skipTest( *it );
+                reporter->skipTest( **it );
         }
 
         context.testGroupEnded( iconfig->name(), totals, 1, 1 );
         return totals;
     }
 
+    Totals replayEventLog( Ptr<Config> const& config ) {
+        Ptr<IStreamingReporter> reporter = addListeners( config.get(), makeReporter( config ) );
+        getCurrentMutableContext().setConfig( config.get() );
+        return EventLogReplayer( reporter ).replay( config->replayFile() );
+    }
+
     void applyFilenamesAsTags( IConfig const& config ) {
-        std::vector<TestCase> const& tests = getAllTestCasesSorted( config );
+        std::vector<TestCase const*> const& tests = getAllTestCasesSorted( config );
         for(std::size_t i = 0; i < tests.size(); ++i ) {
-            TestCase& test = const_cast<TestCase&>( tests[i] );
+            TestCase& test = const_cast<TestCase&>( *tests[i] );
             std::set<std::string> tags = test.tags;
 
             std::string filename = test.lineInfo.file;
@@ -6361,6 +9683,10 @@ namespace Catch {
             try {
                 m_cli.setThrowOnUnrecognisedTokens( unusedOptionBehaviour == OnUnusedOptions::Fail );
                 m_unusedTokens = m_cli.parseInto( Clara::argsToVector( argc, argv ), m_configData );
+                if( m_configData.shardIndex >= m_configData.shardCount )
+                    throw std::runtime_error( "Value after --shard-index must be less than --shard-count" );
+                if( m_configData.runOrder == RunTests::InDurationOrder && m_configData.durationsFile.empty() )
+                    throw std::runtime_error( "--order duration needs a --durations-file" );
                 if( m_configData.showHelp )
                     showHelp( m_configData.processName );
                 m_config.reset();
@@ -6405,6 +9731,9 @@ namespace Catch {
                 if( m_configData.filenamesAsTags )
                     applyFilenamesAsTags( *m_config );
 
+                if( !m_configData.replayFile.empty() )
+                    return static_cast<int>( replayEventLog( m_config ).assertions.failed );
+
                 // Handle list request
                 if( Option<std::size_t> listed = list( config() ) )
                     return static_cast<int>( *listed );
@@ -6481,13 +9810,55 @@ namespace Catch {
         }
     };
 
-    inline std::vector<TestCase> sortTests( IConfig const& config, std::vector<TestCase> const& unsortedTestCases ) {
+    // Longest first, so that under --jobs the long test cases start early
+    // instead of leaving one worker busy at the end. Test cases without a
+    // recorded duration count as average ones
+    class LongerFirst {
+    public:
+        LongerFirst( TestDurations const& durations, std::vector<TestCase const*> const& testCases )
+        :   m_durations( durations ),
+            m_averageDuration( 0 )
+        {
+            uint64_t total = 0;
+            std::size_t count = 0;
+            for( std::size_t i = 0; i < testCases.size(); ++i ) {
+                if( uint64_t const* duration = durations.find( testCases[i]->name ) ) {
+                    total += *duration;
+                    ++count;
+                }
+            }
+            if( count > 0 )
+                m_averageDuration = total / count;
+        }
+
+        bool operator()( TestCase const* lhs, TestCase const* rhs ) const {
+            return durationOf( *lhs ) > durationOf( *rhs );
+        }
+
+    private:
+        uint64_t durationOf( TestCase const& testCase ) const {
+            uint64_t const* duration = m_durations.find( testCase.name );
+            return duration ? *duration : m_averageDuration;
+        }
+
+        TestDurations const& m_durations;
+        uint64_t m_averageDuration;
+    };
+
+    inline bool nameLess( TestCase const* lhs, TestCase const* rhs ) {
+        return *lhs < *rhs;
+    }
+
+    inline std::vector<TestCase const*> sortTests( IConfig const& config, std::vector<TestCase> const& unsortedTestCases ) {
 
-        std::vector<TestCase> sorted = unsortedTestCases;
+        std::vector<TestCase const*> sorted;
+        sorted.reserve( unsortedTestCases.size() );
+        for( std::size_t i = 0; i < unsortedTestCases.size(); ++i )
+            sorted.push_back( &unsortedTestCases[i] );
 
         switch( config.runOrder() ) {
             case RunTests::InLexicographicalOrder:
-                std::sort( sorted.begin(), sorted.end() );
+                std::sort( sorted.begin(), sorted.end(), nameLess );
                 break;
             case RunTests::InRandomOrder:
                 {
@@ -6495,6 +9866,13 @@ namespace Catch {
                     RandomNumberGenerator::shuffle( sorted );
                 }
                 break;
+            case RunTests::InDurationOrder:
+                {
+                    TestDurations durations;
+                    durations.load( config.durationsFile() );
+                    std::stable_sort( sorted.begin(), sorted.end(), LongerFirst( durations, sorted ) );
+                }
+                break;
             case RunTests::InDeclarationOrder:
                 // already in declaration order
                 break;
@@ -6505,36 +9883,131 @@ namespace Catch {
         return testSpec.matches( testCase ) && ( config.allowThrows() || !testCase.throws() );
     }
 
+    // An open addressed table of indices into functions, keyed by name hash,
+    // so that names are only compared when their hashes collide
     void enforceNoDuplicateTestCases( std::vector<TestCase> const& functions ) {
-        std::set<TestCase> seenFunctions;
-        for( std::vector<TestCase>::const_iterator it = functions.begin(), itEnd = functions.end();
-            it != itEnd;
-            ++it ) {
-            std::pair<std::set<TestCase>::const_iterator, bool> prev = seenFunctions.insert( *it );
-            if( !prev.second ) {
+        std::size_t capacity = 16;
+        while( capacity < functions.size() * 2 )
+            capacity *= 2;
+        std::size_t const empty = functions.size();
+        std::vector<std::size_t> slots( capacity, empty );
+        std::vector<uint64_t> hashes( capacity );
+
+        for( std::size_t i = 0; i < functions.size(); ++i ) {
+            uint64_t hash = hashTestName( functions[i].name );
+            std::size_t slot = static_cast<std::size_t>( hash ) & ( capacity-1 );
+            while( slots[slot] != empty &&
+                    ( hashes[slot] != hash || functions[slots[slot]].name != functions[i].name ) )
+                slot = ( slot+1 ) & ( capacity-1 );
+
+            if( slots[slot] != empty ) {
                 std::ostringstream ss;
 
                 ss  << Colour( Colour::Red )
-                    << "error: TEST_CASE( \"" << it->name << "\" ) already defined.\n"
-                    << "\tFirst seen at " << prev.first->getTestCaseInfo().lineInfo << "\n"
-                    << "\tRedefined at " << it->getTestCaseInfo().lineInfo << std::endl;
+                    << "error: TEST_CASE( \"" << functions[i].name << "\" ) already defined.\n"
+                    << "\tFirst seen at " << functions[slots[slot]].getTestCaseInfo().lineInfo << "\n"
+                    << "\tRedefined at " << functions[i].getTestCaseInfo().lineInfo << std::endl;
 
                 throw std::runtime_error(ss.str());
             }
+            slots[slot] = i;
+            hashes[slot] = hash;
         }
     }
 
-    std::vector<TestCase> filterTests( std::vector<TestCase> const& testCases, TestSpec const& testSpec, IConfig const& config ) {
-        std::vector<TestCase> filtered;
+    namespace {
+        struct BalanceCandidate {
+            BalanceCandidate( TestCase const& testCase, std::size_t _index, uint64_t _weight )
+            :   hash( hashTestName( testCase.name ) ),
+                weight( _weight ),
+                index( _index ),
+                name( &testCase.name )
+            {}
+
+            // Heaviest first, then by hash, so the order doesn't depend on the run order
+            bool operator < ( BalanceCandidate const& other ) const {
+                if( weight != other.weight )
+                    return weight > other.weight;
+                if( hash != other.hash )
+                    return hash < other.hash;
+                return *name < *other.name;
+            }
+
+            uint64_t hash;
+            uint64_t weight;
+            std::size_t index;
+            std::string const* name;
+        };
+    }
+
+    // Longest first, each test case goes to the least loaded group so far.
+    // Without durations that is one apiece in hash order
+    std::vector<std::size_t> balanceTests( std::vector<TestCase const*> const& testCases,
+                                           std::size_t groups,
+                                           TestDurations const& durations ) {
+        std::vector<uint64_t const*> recorded( testCases.size() );
+        uint64_t recordedTotal = 0;
+        std::size_t recordedCount = 0;
+        for( std::size_t i = 0; i < testCases.size(); ++i ) {
+            recorded[i] = durations.find( testCases[i]->name );
+            if( recorded[i] ) {
+                recordedTotal += *recorded[i];
+                ++recordedCount;
+            }
+        }
+        uint64_t averageDuration = recordedCount > 0 ? recordedTotal / recordedCount : 1;
+
+        std::vector<BalanceCandidate> candidates;
+        candidates.reserve( testCases.size() );
+        for( std::size_t i = 0; i < testCases.size(); ++i ) {
+            uint64_t duration = recorded[i] ? *recorded[i] : averageDuration;
+            candidates.push_back( BalanceCandidate( *testCases[i], i, (std::max)( duration, static_cast<uint64_t>( 1 ) ) ) );
+        }
+        std::sort( candidates.begin(), candidates.end() );
+
+        std::vector<uint64_t> loads( groups, 0 );
+        std::vector<std::size_t> groupOf( testCases.size(), 0 );
+        for( std::size_t i = 0; i < candidates.size(); ++i ) {
+            std::size_t lightest = 0;
+            for( std::size_t group = 1; group < groups; ++group )
+                if( loads[group] < loads[lightest] )
+                    lightest = group;
+            loads[lightest] += candidates[i].weight;
+            groupOf[candidates[i].index] = lightest;
+        }
+        return groupOf;
+    }
+
+    // Keeps the test cases of --shard-index out of --shard-count balanced
+    // groups. Every shard works out the same groups, so between them they
+    // run each test case exactly once
+    std::vector<TestCase const*> shardTests( std::vector<TestCase const*> const& testCases, IConfig const& config ) {
+        TestDurations durations;
+        if( !config.durationsFile().empty() )
+            durations.load( config.durationsFile() );
+
+        std::vector<std::size_t> shardOf = balanceTests( testCases, static_cast<std::size_t>( config.shardCount() ), durations );
+        std::vector<TestCase const*> sharded;
+        for( std::size_t i = 0; i < testCases.size(); ++i )
+            if( shardOf[i] == static_cast<std::size_t>( config.shardIndex() ) )
+                sharded.push_back( testCases[i] );
+        return sharded;
+    }
+
+    // Keeps the order of testCases, so the result can be walked alongside it
+    std::vector<TestCase const*> filterTests( std::vector<TestCase const*> const& testCases, TestSpec const& testSpec, IConfig const& config ) {
+        std::vector<TestCase const*> filtered;
         filtered.reserve( testCases.size() );
-        for( std::vector<TestCase>::const_iterator it = testCases.begin(), itEnd = testCases.end();
+        for( std::vector<TestCase const*>::const_iterator it = testCases.begin(), itEnd = testCases.end();
                 it != itEnd;
                 ++it )
-            if( matchTest( *it, testSpec, config ) )
+            if( matchTest( **it, testSpec, config ) )
                 filtered.push_back( *it );
+        if( config.shardCount() > 1 )
+            return shardTests( filtered, config );
         return filtered;
     }
-    std::vector<TestCase> const& getAllTestCasesSorted( IConfig const& config ) {
+    std::vector<TestCase const*> const& getAllTestCasesSorted( IConfig const& config ) {
         return getRegistryHub().getTestCaseRegistry().getAllTestsSorted( config );
     }
 
@@ -6554,12 +10027,13 @@ namespace Catch {
                 return registerTest( testCase.withName( oss.str() ) );
             }
             m_functions.push_back( testCase );
+            m_sortedFunctions.clear(); // Its pointers may no longer be valid
         }
 
         virtual std::vector<TestCase> const& getAllTests() const {
             return m_functions;
         }
-        virtual std::vector<TestCase> const& getAllTestsSorted( IConfig const& config ) const {
+        virtual std::vector<TestCase const*> const& getAllTestsSorted( IConfig const& config ) const {
             if( m_sortedFunctions.empty() )
                 enforceNoDuplicateTestCases( m_functions );
 
@@ -6573,7 +10047,7 @@ namespace Catch {
     private:
         std::vector<TestCase> m_functions;
         mutable RunTests::InWhatOrder m_currentSortOrder;
-        mutable std::vector<TestCase> m_sortedFunctions;
+        mutable std::vector<TestCase const*> m_sortedFunctions;
         size_t m_unnamedCount;
         std::ios_base::Init m_ostreamInit; // Forces cout/ cerr to be initialised
     };
@@ -6841,7 +10315,11 @@ namespace Catch {
 
 #include <stdexcept>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <queue>
 
 namespace Catch {
 
@@ -6855,53 +10333,758 @@ namespace Catch {
             setp( data, data + sizeof(data) );
         }
 
-        ~StreamBufImpl() CATCH_NOEXCEPT {
-            sync();
-        }
+        ~StreamBufImpl() CATCH_NOEXCEPT {
+            sync();
+        }
+
+    private:
+        int overflow( int c ) {
+            sync();
+
+            if( c != EOF ) {
+                if( pbase() == epptr() )
+                    m_writer( std::string( 1, static_cast<char>( c ) ) );
+                else
+                    sputc( static_cast<char>( c ) );
+            }
+            return 0;
+        }
+
+        int sync() {
+            if( pbase() != pptr() ) {
+                m_writer( std::string( pbase(), static_cast<std::string::size_type>( pptr() - pbase() ) ) );
+                setp( pbase(), epptr() );
+            }
+            return 0;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    FileStream::FileStream( std::string const& filename, bool binary ) {
+        m_ofs.open( filename.c_str(), binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out );
+        if( m_ofs.fail() ) {
+            std::ostringstream oss;
+            oss << "Unable to open file: '" << filename << "'";
+            throw std::domain_error( oss.str() );
+        }
+    }
+
+    std::ostream& FileStream::stream() const {
+        return m_ofs;
+    }
+
+    struct OutputDebugWriter {
+
+        void operator()( std::string const&str ) {
+            writeToDebugConsole( str );
+        }
+    };
+
+    namespace {
+        BlockBufferedStreamBuf* activeBlockBuffer = CATCH_NULL;
+
+        // Writes out a block buffer before passing anything on to its own
+        // target, so that what was written to each comes out in order
+        class FlushingStreamBuf : public StreamBufBase {
+        public:
+            FlushingStreamBuf( BlockBufferedStreamBuf* first, std::streambuf* target )
+            :   m_first( first ),
+                m_target( target )
+            {}
+
+        private:
+            int overflow( int c ) {
+                if( c == EOF )
+                    return 0;
+                m_first->flushBlock();
+                return m_target->sputc( static_cast<char>( c ) );
+            }
+            std::streamsize xsputn( char const* s, std::streamsize n ) {
+                m_first->flushBlock();
+                return m_target->sputn( s, n );
+            }
+            int sync() {
+                return m_target->pubsync();
+            }
+
+            BlockBufferedStreamBuf* m_first;
+            std::streambuf* m_target;
+        };
+    }
+
+    BlockBufferedStreamBuf::BlockBufferedStreamBuf( std::streambuf* target )
+    :   m_target( target ),
+        m_block( 64*1024 )
+    {
+        setp( &m_block[0], &m_block[0] + m_block.size() );
+    }
+
+    BlockBufferedStreamBuf::~BlockBufferedStreamBuf() CATCH_NOEXCEPT {
+        flushBlock();
+    }
+
+    void BlockBufferedStreamBuf::flushBlock() {
+        writeBlock();
+        m_target->pubsync();
+    }
+
+    int BlockBufferedStreamBuf::overflow( int c ) {
+        writeBlock();
+        if( c != EOF )
+            sputc( static_cast<char>( c ) );
+        return 0;
+    }
+
+    int BlockBufferedStreamBuf::sync() {
+        return 0; // Held until flushBlock()
+    }
+
+    void BlockBufferedStreamBuf::writeBlock() {
+        if( pbase() != pptr() ) {
+            m_target->sputn( pbase(), pptr() - pbase() );
+            setp( pbase(), epptr() );
+        }
+    }
+
+    BufferedStream::BufferedStream( IStream const* inner, bool sharedWithCout )
+    :   m_inner( inner ),
+        m_streamBuf( new BlockBufferedStreamBuf( inner->stream().rdbuf() ) ),
+        m_os( m_streamBuf.get() ),
+        m_prevCoutBuf( CATCH_NULL ),
+        m_prevCerrBuf( CATCH_NULL )
+    {
+        if( sharedWithCout ) {
+            m_prevCoutBuf = Catch::cout().rdbuf( m_streamBuf.get() );
+            m_cerrBuf.reset( new FlushingStreamBuf( m_streamBuf.get(), Catch::cerr().rdbuf() ) );
+            m_prevCerrBuf = Catch::cerr().rdbuf( m_cerrBuf.get() );
+        }
+        activeBlockBuffer = m_streamBuf.get();
+    }
+
+    BufferedStream::~BufferedStream() CATCH_NOEXCEPT {
+        activeBlockBuffer = CATCH_NULL;
+        if( m_prevCoutBuf ) {
+            Catch::cout().rdbuf( m_prevCoutBuf );
+            Catch::cerr().rdbuf( m_prevCerrBuf );
+        }
+    }
+
+    std::ostream& BufferedStream::stream() const {
+        return m_os;
+    }
+
+    void flushBufferedOutput() {
+        if( activeBlockBuffer )
+            activeBlockBuffer->flushBlock();
+    }
+
+    namespace {
+        class FileWriterStreamBuf : public StreamBufBase {
+        public:
+            explicit FileWriterStreamBuf( std::FILE* file )
+            :   m_file( file ),
+                m_block( 64*1024 )
+            {
+                setp( &m_block[0], &m_block[0] + m_block.size() );
+            }
+            ~FileWriterStreamBuf() CATCH_NOEXCEPT {
+                sync();
+            }
+
+        private:
+            int overflow( int c ) {
+                if( sync() != 0 )
+                    return EOF;
+                if( c != EOF )
+                    sputc( static_cast<char>( c ) );
+                return 0;
+            }
+
+            int sync() {
+                if( pbase() != pptr() ) {
+                    // The file may have been read from since the last write
+                    std::fseek( m_file, 0, SEEK_END );
+                    std::size_t size = static_cast<std::size_t>( pptr() - pbase() );
+                    bool written = std::fwrite( pbase(), 1, size, m_file ) == size;
+                    setp( pbase(), epptr() );
+                    if( !written )
+                        return -1;
+                }
+                return 0;
+            }
+
+            std::FILE* m_file;
+            std::vector<char> m_block;
+        };
+
+        class StringWriterStreamBuf : public StreamBufBase {
+        public:
+            explicit StringWriterStreamBuf( std::string& target ) : m_target( target ) {}
+
+        private:
+            int overflow( int c ) {
+                if( c != EOF )
+                    m_target += static_cast<char>( c );
+                return 0;
+            }
+            std::streamsize xsputn( char const* s, std::streamsize n ) {
+                m_target.append( s, static_cast<std::size_t>( n ) );
+                return n;
+            }
+
+            std::string& m_target;
+        };
+    }
+
+    TempFileStream::TempFileStream()
+    :   m_file( std::tmpfile() ),
+        m_streamBuf( m_file
+            ? static_cast<StreamBufBase*>( new FileWriterStreamBuf( m_file ) )
+            : new StringWriterStreamBuf( m_memory ) ),
+        m_os( m_streamBuf.get() )
+    {}
+
+    TempFileStream::~TempFileStream() CATCH_NOEXCEPT {
+        m_streamBuf.reset();
+        if( m_file )
+            std::fclose( m_file );
+    }
+
+    std::size_t TempFileStream::size() const {
+        if( !m_file )
+            return m_memory.size();
+        m_os.flush();
+        std::fseek( m_file, 0, SEEK_END );
+        return static_cast<std::size_t>( std::ftell( m_file ) );
+    }
+
+    bool TempFileStream::readBlock( std::size_t& offset, std::string& block ) const {
+        static std::size_t const blockSize = 16*1024;
+        if( !m_file ) {
+            block.assign( m_memory, (std::min)( offset, m_memory.size() ), blockSize );
+            offset += block.size();
+            return !block.empty();
+        }
+        m_os.flush();
+        char buffer[blockSize];
+        std::fseek( m_file, static_cast<long>( offset ), SEEK_SET );
+        std::size_t read = std::fread( buffer, 1, sizeof(buffer), m_file );
+        block.assign( buffer, read );
+        offset += read;
+        return read != 0;
+    }
+
+    void TempFileStream::copyTo( std::ostream& os, std::size_t from, std::size_t to ) const {
+        std::string block;
+        while( from < to && readBlock( from, block ) ) {
+            if( from > to )
+                block.resize( block.size() - ( from - to ) );
+            os << block;
+        }
+    }
+
+    std::ostream& TempFileStream::stream() const {
+        return m_os;
+    }
+
+    namespace {
+        // Bit reverses a Huffman code, as deflate writes codes starting from
+        // their most significant bit into a stream that is filled from the least
+        inline unsigned short reverseBits( unsigned int code, unsigned int bits ) {
+            unsigned int reversed = 0;
+            for( unsigned int i = 0; i < bits; ++i )
+                reversed |= ( ( code >> i ) & 1 ) << ( bits - 1 - i );
+            return static_cast<unsigned short>( reversed );
+        }
+
+        // Huffman code lengths for the frequencies given, none of them longer than
+        // maxBits. When the tree comes out too deep the frequencies are flattened
+        // and it is built again, which costs little compression in practice
+        inline void huffmanCodeLengths( std::vector<uint32_t> frequencies, unsigned int maxBits, std::vector<unsigned char>& lengths ) {
+            typedef std::pair<uint32_t, std::size_t> Node;
+            std::size_t count = frequencies.size();
+            lengths.assign( count, 0 );
+            for(;;) {
+                std::priority_queue<Node, std::vector<Node>, std::greater<Node> > queue;
+                for( std::size_t i = 0; i < count; ++i ) {
+                    if( frequencies[i] > 0 )
+                        queue.push( Node( frequencies[i], i ) );
+                }
+                if( queue.size() < 2 ) {
+                    if( !queue.empty() )
+                        lengths[queue.top().second] = 1;
+                    return;
+                }
+                // Leaves first, then each parent after both its children
+                std::vector<std::size_t> parents( count, 0 );
+                while( queue.size() > 1 ) {
+                    Node first = queue.top(); queue.pop();
+                    Node second = queue.top(); queue.pop();
+                    std::size_t parent = parents.size();
+                    parents.push_back( 0 );
+                    parents[first.second] = parent;
+                    parents[second.second] = parent;
+                    queue.push( Node( first.first + second.first, parent ) );
+                }
+                std::vector<unsigned int> depths( parents.size(), 0 );
+                for( std::size_t node = parents.size() - 1; node-- > 0; ) {
+                    if( node >= count || frequencies[node] > 0 )
+                        depths[node] = depths[parents[node]] + 1;
+                }
+                unsigned int deepest = 0;
+                for( std::size_t i = 0; i < count; ++i ) {
+                    lengths[i] = static_cast<unsigned char>( depths[i] );
+                    deepest = std::max( deepest, depths[i] );
+                }
+                if( deepest <= maxBits )
+                    return;
+                for( std::size_t i = 0; i < count; ++i ) {
+                    if( frequencies[i] > 0 )
+                        frequencies[i] = ( frequencies[i] >> 1 ) | 1;
+                }
+            }
+        }
+
+        // The codes that go with a set of code lengths (RFC 1951 section 3.2.2)
+        inline void canonicalCodes( std::vector<unsigned char> const& lengths, std::vector<unsigned short>& codes ) {
+            unsigned int lengthCounts[16] = { 0 };
+            for( std::size_t i = 0; i < lengths.size(); ++i ) {
+                if( lengths[i] > 0 )
+                    ++lengthCounts[lengths[i]];
+            }
+            unsigned int nextCodes[16] = { 0 };
+            unsigned int code = 0;
+            for( unsigned int bits = 1; bits < 16; ++bits ) {
+                code = ( code + lengthCounts[bits - 1] ) << 1;
+                nextCodes[bits] = code;
+            }
+            codes.assign( lengths.size(), 0 );
+            for( std::size_t i = 0; i < lengths.size(); ++i ) {
+                if( lengths[i] > 0 )
+                    codes[i] = reverseBits( nextCodes[lengths[i]]++, lengths[i] );
+            }
+        }
+
+        struct DeflateTables {
+            DeflateTables() {
+                static unsigned short const lengthBases[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+                static unsigned char const lengthExtras[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+                for( unsigned int code = 0; code < 29; ++code ) {
+                    unsigned int end = code < 28 ? lengthBases[code + 1] : 259;
+                    for( unsigned int length = lengthBases[code]; length < end; ++length ) {
+                        lengthSymbol[length] = static_cast<unsigned short>( 257 + code );
+                        lengthExtraBits[length] = lengthExtras[code];
+                        lengthExtraValue[length] = static_cast<unsigned short>( length - lengthBases[code] );
+                    }
+                }
+                static unsigned short const distanceBases[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+                for( unsigned int code = 0; code < 30; ++code ) {
+                    distanceBase[code] = distanceBases[code];
+                    distanceExtraBits[code] = static_cast<unsigned char>( code < 4 ? 0 : code / 2 - 1 );
+                }
+
+                // The fixed codes of section 3.2.6 are the canonical codes for these lengths
+                std::vector<unsigned char> lengths( 288, 8 );
+                std::fill( lengths.begin() + 144, lengths.begin() + 256, 9 );
+                std::fill( lengths.begin() + 256, lengths.begin() + 280, 7 );
+                fixedLiteralLengths = lengths;
+                canonicalCodes( fixedLiteralLengths, fixedLiteralCodes );
+                fixedDistanceLengths.assign( 30, 5 );
+                canonicalCodes( fixedDistanceLengths, fixedDistanceCodes );
+
+                for( uint32_t i = 0; i < 256; ++i ) {
+                    uint32_t crc = i;
+                    for( int bit = 0; bit < 8; ++bit )
+                        crc = ( crc & 1 ) ? 0xEDB88320U ^ ( crc >> 1 ) : crc >> 1;
+                    crcTable[i] = crc;
+                }
+            }
+
+            unsigned int distanceCode( unsigned int distance ) const {
+                return static_cast<unsigned int>( std::upper_bound( distanceBase, distanceBase + 30, distance ) - distanceBase ) - 1;
+            }
+
+            static DeflateTables const& get() {
+                static DeflateTables tables;
+                return tables;
+            }
+
+            unsigned short lengthSymbol[259];
+            unsigned char lengthExtraBits[259];
+            unsigned short lengthExtraValue[259];
+            unsigned int distanceBase[30];
+            unsigned char distanceExtraBits[30];
+            std::vector<unsigned char> fixedLiteralLengths;
+            std::vector<unsigned short> fixedLiteralCodes;
+            std::vector<unsigned char> fixedDistanceLengths;
+            std::vector<unsigned short> fixedDistanceCodes;
+            uint32_t crcTable[256];
+        };
+
+        // Deflates everything written to it into a gzip member on another
+        // streambuf. Input is compressed a block at a time: matched against a
+        // sliding 32KB window with hash chains, then Huffman coded with codes
+        // made for the block, or the fixed codes where those come out smaller
+        class GzipStreamBuf : public StreamBufBase {
+        public:
+            explicit GzipStreamBuf( std::streambuf* target )
+            :   m_target( target ),
+                m_data( windowSize + blockSize ),
+                m_start( 0 ),
+                m_head( hashSize, -1 ),
+                m_prev( windowSize, -1 ),
+                m_literalFrequencies( 286 ),
+                m_distanceFrequencies( 30 ),
+                m_crc( 0xFFFFFFFFU ),
+                m_size( 0 ),
+                m_bitBuffer( 0 ),
+                m_bitCount( 0 ),
+                m_finished( false )
+            {
+                static unsigned char const header[] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+                m_out.append( reinterpret_cast<char const*>( header ), sizeof( header ) );
+                m_tokens.reserve( blockSize );
+                setp( &m_data[0], &m_data[0] + m_data.size() );
+            }
+            ~GzipStreamBuf() CATCH_NOEXCEPT {
+                finish();
+            }
+
+            void finish() {
+                if( m_finished )
+                    return;
+                m_finished = true;
+                compressPending( true );
+                if( m_bitCount > 0 )
+                    writeBits( 0, 8 - m_bitCount );
+                writeLittleEndian( m_crc ^ 0xFFFFFFFFU );
+                writeLittleEndian( m_size );
+                writeOut();
+                m_target->pubsync();
+                setp( CATCH_NULL, CATCH_NULL );
+            }
+
+        private:
+            enum {
+                windowSize = 32*1024,
+                blockSize = 64*1024,
+                hashSize = 32*1024,
+                minMatch = 3,
+                maxMatch = 258,
+                maxChain = 16,
+                endOfBlock = 256
+            };
+
+            // A literal byte when distance is 0, otherwise a match
+            struct Token {
+                unsigned short length;
+                unsigned short distance;
+            };
+
+            int overflow( int c ) {
+                if( m_finished )
+                    return EOF;
+                compressPending( false );
+                slideWindow();
+                if( c != EOF )
+                    sputc( static_cast<char>( c ) );
+                return 0;
+            }
+
+            int sync() {
+                return 0; // A block per flush would cost more than it saves
+            }
+
+            unsigned int hashAt( int pos ) const {
+                unsigned char const* p = reinterpret_cast<unsigned char const*>( &m_data[0] ) + pos;
+                return ( ( static_cast<unsigned int>( p[0] ) << 10 ) ^ ( static_cast<unsigned int>( p[1] ) << 5 ) ^ p[2] ) & ( hashSize - 1 );
+            }
+            // Returns the previous position with the same hash
+            int insertHash( int pos ) {
+                unsigned int hash = hashAt( pos );
+                int previous = m_head[hash];
+                m_prev[static_cast<std::size_t>( pos ) & ( windowSize - 1 )] = previous;
+                m_head[hash] = pos;
+                return previous;
+            }
+
+            void compressPending( bool last ) {
+                int end = static_cast<int>( pptr() - &m_data[0] );
+                if( end == m_start && !last )
+                    return;
+
+                DeflateTables const& tables = DeflateTables::get();
+                for( int i = m_start; i < end; ++i )
+                    m_crc = tables.crcTable[( m_crc ^ static_cast<unsigned char>( m_data[static_cast<std::size_t>( i )] ) ) & 0xFF] ^ ( m_crc >> 8 );
+                m_size += static_cast<uint32_t>( end - m_start );
+
+                findMatches( end );
+                writeBlock( last );
+                m_start = end;
+                writeOut();
+            }
+
+            void findMatches( int end ) {
+                DeflateTables const& tables = DeflateTables::get();
+                char const* data = &m_data[0];
+                int pos = m_start;
+                while( pos < end ) {
+                    int bestLength = 0;
+                    int bestDistance = 0;
+                    if( end - pos >= minMatch ) {
+                        int limit = std::min<int>( maxMatch, end - pos );
+                        int candidate = insertHash( pos );
+                        for( int chain = 0; candidate >= 0 && pos - candidate <= windowSize && chain < maxChain; ++chain ) {
+                            if( data[candidate + bestLength] == data[pos + bestLength] ) {
+                                int length = 0;
+                                while( length < limit && data[candidate + length] == data[pos + length] )
+                                    ++length;
+                                if( length > bestLength ) {
+                                    bestLength = length;
+                                    bestDistance = pos - candidate;
+                                    if( length == limit )
+                                        break;
+                                }
+                            }
+                            int next = m_prev[static_cast<std::size_t>( candidate ) & ( windowSize - 1 )];
+                            if( next >= candidate )
+                                break;
+                            candidate = next;
+                        }
+                    }
+                    Token token;
+                    if( bestLength >= minMatch ) {
+                        token.length = static_cast<unsigned short>( bestLength );
+                        token.distance = static_cast<unsigned short>( bestDistance );
+                        ++m_literalFrequencies[tables.lengthSymbol[bestLength]];
+                        ++m_distanceFrequencies[tables.distanceCode( static_cast<unsigned int>( bestDistance ) )];
+                        for( int i = pos + 1; i < pos + bestLength && end - i >= minMatch; ++i )
+                            insertHash( i );
+                        pos += bestLength;
+                    }
+                    else {
+                        token.length = static_cast<unsigned char>( data[pos] );
+                        token.distance = 0;
+                        ++m_literalFrequencies[token.length];
+                        ++pos;
+                    }
+                    m_tokens.push_back( token );
+                }
+                ++m_literalFrequencies[endOfBlock];
+            }
+
+            void writeBlock( bool last ) {
+                DeflateTables const& tables = DeflateTables::get();
+
+                std::vector<unsigned char> literalLengths, distanceLengths;
+                huffmanCodeLengths( m_literalFrequencies, 15, literalLengths );
+                huffmanCodeLengths( m_distanceFrequencies, 15, distanceLengths );
+                if( std::count( distanceLengths.begin(), distanceLengths.end(), 0 ) == static_cast<std::ptrdiff_t>( distanceLengths.size() ) )
+                    distanceLengths[0] = 1; // There has to be at least one distance code
+
+                std::size_t literalCount = 286;
+                while( literalCount > 257 && literalLengths[literalCount - 1] == 0 )
+                    --literalCount;
+                std::size_t distanceCount = 30;
+                while( distanceCount > 1 && distanceLengths[distanceCount - 1] == 0 )
+                    --distanceCount;
+
+                // Both sets of lengths are sent run length encoded, with their own Huffman code
+                std::vector<unsigned char> allLengths( literalLengths.begin(), literalLengths.begin() + static_cast<std::ptrdiff_t>( literalCount ) );
+                allLengths.insert( allLengths.end(), distanceLengths.begin(), distanceLengths.begin() + static_cast<std::ptrdiff_t>( distanceCount ) );
+                std::vector<std::pair<unsigned char, unsigned char> > runs;
+                std::vector<uint32_t> runFrequencies( 19 );
+                encodeRuns( allLengths, runs, runFrequencies );
+                std::vector<unsigned char> runLengths;
+                huffmanCodeLengths( runFrequencies, 7, runLengths );
+
+                static unsigned char const runLengthOrder[] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+                std::size_t runLengthCount = 19;
+                while( runLengthCount > 4 && runLengths[runLengthOrder[runLengthCount - 1]] == 0 )
+                    --runLengthCount;
+
+                uint64_t dynamicBits = 14 + 3 * runLengthCount;
+                for( std::size_t i = 0; i < runs.size(); ++i )
+                    dynamicBits += runLengths[runs[i].first] + ( runs[i].first == 16 ? 2 : runs[i].first == 17 ? 3 : runs[i].first == 18 ? 7 : 0 );
+                uint64_t fixedBits = 0;
+                for( std::size_t i = 0; i < 286; ++i ) {
+                    dynamicBits += static_cast<uint64_t>( m_literalFrequencies[i] ) * literalLengths[i];
+                    fixedBits += static_cast<uint64_t>( m_literalFrequencies[i] ) * tables.fixedLiteralLengths[i];
+                }
+                for( std::size_t i = 0; i < 30; ++i ) {
+                    dynamicBits += static_cast<uint64_t>( m_distanceFrequencies[i] ) * distanceLengths[i];
+                    fixedBits += static_cast<uint64_t>( m_distanceFrequencies[i] ) * tables.fixedDistanceLengths[i];
+                }
 
-    private:
-        int overflow( int c ) {
-            sync();
+                if( fixedBits <= dynamicBits ) {
+                    writeBits( last ? 3 : 2, 3 );
+                    writeTokens( tables.fixedLiteralLengths, tables.fixedLiteralCodes, tables.fixedDistanceLengths, tables.fixedDistanceCodes );
+                }
+                else {
+                    writeBits( last ? 5 : 4, 3 );
+                    writeBits( static_cast<uint32_t>( literalCount - 257 ), 5 );
+                    writeBits( static_cast<uint32_t>( distanceCount - 1 ), 5 );
+                    writeBits( static_cast<uint32_t>( runLengthCount - 4 ), 4 );
+                    for( std::size_t i = 0; i < runLengthCount; ++i )
+                        writeBits( runLengths[runLengthOrder[i]], 3 );
+                    std::vector<unsigned short> runCodes;
+                    canonicalCodes( runLengths, runCodes );
+                    for( std::size_t i = 0; i < runs.size(); ++i ) {
+                        unsigned char symbol = runs[i].first;
+                        writeBits( runCodes[symbol], runLengths[symbol] );
+                        if( symbol == 16 )
+                            writeBits( runs[i].second, 2 );
+                        else if( symbol == 17 )
+                            writeBits( runs[i].second, 3 );
+                        else if( symbol == 18 )
+                            writeBits( runs[i].second, 7 );
+                    }
+                    std::vector<unsigned short> literalCodes, distanceCodes;
+                    canonicalCodes( literalLengths, literalCodes );
+                    canonicalCodes( distanceLengths, distanceCodes );
+                    writeTokens( literalLengths, literalCodes, distanceLengths, distanceCodes );
+                }
 
-            if( c != EOF ) {
-                if( pbase() == epptr() )
-                    m_writer( std::string( 1, static_cast<char>( c ) ) );
-                else
-                    sputc( static_cast<char>( c ) );
+                m_tokens.clear();
+                std::fill( m_literalFrequencies.begin(), m_literalFrequencies.end(), 0 );
+                std::fill( m_distanceFrequencies.begin(), m_distanceFrequencies.end(), 0 );
+            }
+
+            // Code lengths as the symbols of section 3.2.7: a length, 16 to repeat
+            // the last one 3-6 times, or 17 and 18 for 3-10 and 11-138 zeros
+            static void encodeRuns( std::vector<unsigned char> const& lengths, std::vector<std::pair<unsigned char, unsigned char> >& runs, std::vector<uint32_t>& frequencies ) {
+                typedef std::pair<unsigned char, unsigned char> Run;
+                for( std::size_t i = 0; i < lengths.size(); ) {
+                    unsigned char length = lengths[i];
+                    std::size_t repeats = 1;
+                    while( i + repeats < lengths.size() && lengths[i + repeats] == length )
+                        ++repeats;
+                    i += repeats;
+                    if( length == 0 ) {
+                        while( repeats >= 11 ) {
+                            std::size_t run = std::min<std::size_t>( repeats, 138 );
+                            runs.push_back( Run( 18, static_cast<unsigned char>( run - 11 ) ) );
+                            repeats -= run;
+                        }
+                        if( repeats >= 3 ) {
+                            runs.push_back( Run( 17, static_cast<unsigned char>( repeats - 3 ) ) );
+                            repeats = 0;
+                        }
+                    }
+                    else {
+                        runs.push_back( Run( length, 0 ) );
+                        --repeats;
+                        while( repeats >= 3 ) {
+                            std::size_t run = std::min<std::size_t>( repeats, 6 );
+                            runs.push_back( Run( 16, static_cast<unsigned char>( run - 3 ) ) );
+                            repeats -= run;
+                        }
+                    }
+                    for( ; repeats > 0; --repeats )
+                        runs.push_back( Run( length, 0 ) );
+                }
+                for( std::size_t i = 0; i < runs.size(); ++i )
+                    ++frequencies[runs[i].first];
+            }
+
+            void writeTokens(   std::vector<unsigned char> const& literalLengths,
+                                std::vector<unsigned short> const& literalCodes,
+                                std::vector<unsigned char> const& distanceLengths,
+                                std::vector<unsigned short> const& distanceCodes ) {
+                DeflateTables const& tables = DeflateTables::get();
+                for( std::vector<Token>::const_iterator it = m_tokens.begin(), itEnd = m_tokens.end(); it != itEnd; ++it ) {
+                    if( it->distance == 0 ) {
+                        writeBits( literalCodes[it->length], literalLengths[it->length] );
+                        continue;
+                    }
+                    unsigned int symbol = tables.lengthSymbol[it->length];
+                    writeBits( literalCodes[symbol], literalLengths[symbol] );
+                    writeBits( tables.lengthExtraValue[it->length], tables.lengthExtraBits[it->length] );
+                    unsigned int code = tables.distanceCode( it->distance );
+                    writeBits( distanceCodes[code], distanceLengths[code] );
+                    writeBits( it->distance - tables.distanceBase[code], tables.distanceExtraBits[code] );
+                }
+                writeBits( literalCodes[endOfBlock], literalLengths[endOfBlock] );
+            }
+
+            // Keeps the last window of input, for matches to refer back to
+            void slideWindow() {
+                int shift = m_start - windowSize;
+                if( shift > 0 ) {
+                    std::memmove( &m_data[0], &m_data[0] + shift, windowSize );
+                    m_start = windowSize;
+                    for( std::size_t i = 0; i < m_head.size(); ++i )
+                        m_head[i] = m_head[i] >= shift ? m_head[i] - shift : -1;
+                    // Positions move by a multiple of the window, so m_prev keeps its order
+                    for( std::size_t i = 0; i < m_prev.size(); ++i )
+                        m_prev[i] = m_prev[i] >= shift ? m_prev[i] - shift : -1;
+                }
+                setp( &m_data[0] + m_start, &m_data[0] + m_data.size() );
             }
-            return 0;
-        }
 
-        int sync() {
-            if( pbase() != pptr() ) {
-                m_writer( std::string( pbase(), static_cast<std::string::size_type>( pptr() - pbase() ) ) );
-                setp( pbase(), epptr() );
+            void writeBits( uint32_t bits, unsigned int count ) {
+                m_bitBuffer |= bits << m_bitCount;
+                m_bitCount += count;
+                while( m_bitCount >= 8 ) {
+                    m_out += static_cast<char>( m_bitBuffer & 0xFF );
+                    m_bitBuffer >>= 8;
+                    m_bitCount -= 8;
+                }
             }
-            return 0;
-        }
-    };
+            void writeLittleEndian( uint32_t value ) {
+                for( int i = 0; i < 4; ++i )
+                    m_out += static_cast<char>( ( value >> ( 8 * i ) ) & 0xFF );
+            }
+            void writeOut() {
+                m_target->sputn( m_out.data(), static_cast<std::streamsize>( m_out.size() ) );
+                m_out.clear();
+            }
+
+            std::streambuf* m_target;
+            std::vector<char> m_data; // The window, then input not yet compressed
+            int m_start; // Where the input not yet compressed starts
+            std::vector<int> m_head;
+            std::vector<int> m_prev;
+            std::vector<Token> m_tokens;
+            std::vector<uint32_t> m_literalFrequencies;
+            std::vector<uint32_t> m_distanceFrequencies;
+            uint32_t m_crc;
+            uint32_t m_size;
+            uint32_t m_bitBuffer;
+            unsigned int m_bitCount;
+            std::string m_out;
+            bool m_finished;
+        };
 
-    ///////////////////////////////////////////////////////////////////////////
+        GzipStreamBuf* activeCompressor = CATCH_NULL;
+    }
 
-    FileStream::FileStream( std::string const& filename ) {
-        m_ofs.open( filename.c_str() );
+    GzipFileStream::GzipFileStream( std::string const& filename )
+    :   m_ofs( filename.c_str(), std::ios_base::out | std::ios_base::binary ),
+        m_streamBuf( m_ofs.fail() ? CATCH_NULL : new GzipStreamBuf( m_ofs.rdbuf() ) ),
+        m_os( m_streamBuf.get() )
+    {
         if( m_ofs.fail() ) {
             std::ostringstream oss;
             oss << "Unable to open file: '" << filename << "'";
             throw std::domain_error( oss.str() );
         }
+        activeCompressor = static_cast<GzipStreamBuf*>( m_streamBuf.get() );
     }
 
-    std::ostream& FileStream::stream() const {
-        return m_ofs;
+    GzipFileStream::~GzipFileStream() CATCH_NOEXCEPT {
+        activeCompressor = CATCH_NULL;
     }
 
-    struct OutputDebugWriter {
+    std::ostream& GzipFileStream::stream() const {
+        return m_os;
+    }
 
-        void operator()( std::string const&str ) {
-            writeToDebugConsole( str );
-        }
-    };
+    void finishCompressedOutput() {
+        if( activeCompressor )
+            activeCompressor->finish();
+    }
 
     DebugOutStream::DebugOutStream()
     :   m_streamBuf( new StreamBufImpl<OutputDebugWriter>() ),
@@ -7444,10 +11627,28 @@ namespace Catch {
         return TestCase( _testCase, info );
     }
 
+    std::size_t internTag( std::string const& lcaseTag ) {
+        static std::map<std::string, std::size_t> ids;
+        return ids.insert( std::make_pair( lcaseTag, ids.size() ) ).first->second;
+    }
+
+    uint64_t hashTestName( std::string const& name ) {
+        // 64-bit FNV-1a; the constants are built up as C++98 has no long long literals
+        uint64_t const fnvOffsetBasis = ( static_cast<uint64_t>( 0xcbf29ce4 ) << 32 ) | 0x84222325;
+        uint64_t const fnvPrime = ( static_cast<uint64_t>( 0x100 ) << 32 ) | 0x1b3;
+        uint64_t hash = fnvOffsetBasis;
+        for( std::size_t i = 0; i < name.size(); ++i ) {
+            hash ^= static_cast<unsigned char>( name[i] );
+            hash *= fnvPrime;
+        }
+        return hash;
+    }
+
     void setTags( TestCaseInfo& testCaseInfo, std::set<std::string> const& tags )
     {
         testCaseInfo.tags = tags;
         testCaseInfo.lcaseTags.clear();
+        testCaseInfo.tagBits.clear();
 
         std::ostringstream oss;
         for( std::set<std::string>::const_iterator it = tags.begin(), itEnd = tags.end(); it != itEnd; ++it ) {
@@ -7455,6 +11656,7 @@ namespace Catch {
             std::string lcaseTag = toLower( *it );
             testCaseInfo.properties = static_cast<TestCaseInfo::SpecialProperties>( testCaseInfo.properties | parseSpecialTag( lcaseTag ) );
             testCaseInfo.lcaseTags.insert( lcaseTag );
+            testCaseInfo.tagBits.set( internTag( lcaseTag ) );
         }
         testCaseInfo.tagsAsString = oss.str();
     }
@@ -7479,6 +11681,7 @@ namespace Catch {
         description( other.description ),
         tags( other.tags ),
         lcaseTags( other.lcaseTags ),
+        tagBits( other.tagBits ),
         tagsAsString( other.tagsAsString ),
         lineInfo( other.lineInfo ),
         properties( other.properties )
@@ -7517,6 +11720,7 @@ namespace Catch {
         description.swap( other.description );
         tags.swap( other.tags );
         lcaseTags.swap( other.lcaseTags );
+        tagBits.swap( other.tagBits );
         tagsAsString.swap( other.tagsAsString );
         std::swap( TestCaseInfo::properties, static_cast<TestCaseInfo&>( other ).properties );
         std::swap( lineInfo, other.lineInfo );
@@ -7601,18 +11805,97 @@ namespace Catch {
 
     ////////////////////////////////////////////////////////////////////////////
 
+    // Each value is held as its write function and size, then its bytes
+    void MessageArena::append( WriteFunction write, void const* data, std::size_t size ) {
+        std::size_t offset = m_data.size();
+        m_data.resize( offset + sizeof( write ) + sizeof( size ) + size );
+        std::memcpy( &m_data[offset], &write, sizeof( write ) );
+        std::memcpy( &m_data[offset + sizeof( write )], &size, sizeof( size ) );
+        if( size > 0 )
+            std::memcpy( &m_data[offset + sizeof( write ) + sizeof( size )], data, size );
+    }
+    void MessageArena::truncate( std::size_t size ) {
+        if( size < m_data.size() )
+            m_data.resize( size );
+    }
+    void MessageArena::writeTo( std::ostream& os, std::size_t begin, std::size_t end ) const {
+        while( begin < end ) {
+            WriteFunction write;
+            std::size_t size;
+            std::memcpy( &write, &m_data[begin], sizeof( write ) );
+            std::memcpy( &size, &m_data[begin + sizeof( write )], sizeof( size ) );
+            begin += sizeof( write ) + sizeof( size );
+            write( os, size > 0 ? &m_data[begin] : CATCH_NULL, size );
+            begin += size;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    MessageBuilder::MessageBuilder( std::string const& macroName,
+                                    SourceLineInfo const& lineInfo,
+                                    ResultWas::OfType type )
+    :   m_info( macroName, lineInfo, type ),
+        m_arena( &getResultCapture().messageArena() ),
+        m_begin( m_arena->size() ),
+        m_formatted( false )
+    {}
+
+    MessageBuilder& MessageBuilder::operator << ( char const* value ) {
+        if( !value )
+            return *this << "{null string}"; // as toString() writes it
+        return capture( &MessageBuilder::writeChars, value, std::strlen( value ) );
+    }
+    MessageBuilder& MessageBuilder::operator << ( std::string const& value ) {
+        return capture( &MessageBuilder::writeChars, value.data(), value.size() );
+    }
+
+    MessageArgs MessageBuilder::args() const {
+        return m_formatted
+            ? MessageArgs( m_begin, m_begin )
+            : MessageArgs( m_begin, m_arena->size() );
+    }
+
+    void MessageBuilder::writeChars( std::ostream& os, char const* data, std::size_t size ) {
+        os.write( data, static_cast<std::streamsize>( size ) );
+    }
+
+    MessageBuilder& MessageBuilder::capture( MessageArena::WriteFunction write, void const* data, std::size_t size ) {
+        if( m_formatted )
+            write( stream(), static_cast<char const*>( data ), size );
+        else
+            m_arena->append( write, data, size );
+        return *this;
+    }
+
+    std::ostream& MessageBuilder::stream() {
+        if( !m_formatted ) {
+            // Whatever was held so far is written first, so the stream sees
+            // the values in order and any state they rely on carries over
+            m_formatted = true;
+            m_arena->writeTo( m_stream.stream(), m_begin, m_arena->size() );
+            m_arena->truncate( m_begin );
+        }
+        return m_stream.stream();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+
     ScopedMessage::ScopedMessage( MessageBuilder const& builder )
-    : m_info( builder.m_info )
+    :   m_info( builder.m_info ),
+        m_args( builder.args() )
     {
-        m_info.message = builder.m_stream.str();
-        getResultCapture().pushScopedMessage( m_info );
+        if( builder.isFormatted() )
+            m_info.message = builder.str();
+        getResultCapture().pushScopedMessage( m_info, m_args );
     }
     ScopedMessage::ScopedMessage( ScopedMessage const& other )
-    : m_info( other.m_info )
+    :   m_info( other.m_info ),
+        m_args( other.m_args )
     {}
 
     ScopedMessage::~ScopedMessage() {
-        getResultCapture().popScopedMessage( m_info );
+        getResultCapture().popScopedMessage( m_info, m_args );
     }
 
 } // end namespace Catch
@@ -7659,6 +11942,7 @@ namespace Catch
         virtual void sectionStarting( SectionInfo const& sectionInfo );
         virtual void assertionStarting( AssertionInfo const& );
         virtual bool assertionEnded( AssertionStats const& assertionStats );
+        virtual void benchmarkEnded( BenchmarkStats const& );
         virtual void sectionEnded( SectionStats const& sectionStats );
         virtual void testCaseEnded( TestCaseStats const& testCaseStats );
         virtual void testGroupEnded( TestGroupStats const& testGroupStats );
@@ -7717,6 +12001,9 @@ namespace Catch
         m_legacyReporter->Result( assertionStats.assertionResult );
         return true;
     }
+    void LegacyReporterAdapter::benchmarkEnded( BenchmarkStats const& ) {
+        // Not on legacy interface
+    }
     void LegacyReporterAdapter::sectionEnded( SectionStats const& sectionStats ) {
         if( sectionStats.missingAssertions )
             m_legacyReporter->NoAssertionsInSection( sectionStats.sectionInfo.name );
@@ -7750,15 +12037,27 @@ namespace Catch
 
 #ifdef CATCH_PLATFORM_WINDOWS
 #include <windows.h>
-#else
+#elif defined(CATCH_PLATFORM_MAC)
+#include <mach/mach.h>
+#include <mach/mach_time.h>
 #include <sys/time.h>
+#else
+#include <time.h>
 #endif
 
+#include <ctime>
+#include <sstream>
+#include <iomanip>
+
 namespace Catch {
 
     namespace {
+        // C++98 has no long long literals, and these fit in a long anyway
+        uint64_t const nanosecondsPerSecond = 1000000000;
+        uint64_t const nanosecondsPerMicrosecond = 1000;
+
 #ifdef CATCH_PLATFORM_WINDOWS
-        uint64_t getCurrentTicks() {
+        uint64_t getCurrentNanoseconds() {
             static uint64_t hz=0, hzo=0;
             if (!hz) {
                 QueryPerformanceFrequency( reinterpret_cast<LARGE_INTEGER*>( &hz ) );
@@ -7766,28 +12065,106 @@ namespace Catch {
             }
             uint64_t t;
             QueryPerformanceCounter( reinterpret_cast<LARGE_INTEGER*>( &t ) );
-            return ((t-hzo)*1000000)/hz;
+            t -= hzo;
+            // Convert whole seconds and the remainder separately so this can't overflow
+            return ( t / hz ) * nanosecondsPerSecond + ( ( t % hz ) * nanosecondsPerSecond ) / hz;
+        }
+        uint64_t getCurrentThreadCpuNanoseconds() {
+            FILETIME creationTime, exitTime, kernelTime, userTime;
+            if( !GetThreadTimes( GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime ) )
+                return 0;
+            uint64_t kernel = ( static_cast<uint64_t>( kernelTime.dwHighDateTime ) << 32 ) | kernelTime.dwLowDateTime;
+            uint64_t user = ( static_cast<uint64_t>( userTime.dwHighDateTime ) << 32 ) | userTime.dwLowDateTime;
+            return ( kernel + user ) * 100; // FILETIMEs count 100ns intervals
+        }
+#elif defined(CATCH_PLATFORM_MAC)
+        uint64_t getCurrentNanoseconds() {
+            static mach_timebase_info_data_t timebase = { 0, 0 };
+            if( timebase.denom == 0 )
+                mach_timebase_info( &timebase );
+            return mach_absolute_time() * timebase.numer / timebase.denom;
+        }
+        uint64_t getCurrentThreadCpuNanoseconds() {
+            mach_port_t thread = mach_thread_self();
+            thread_basic_info_data_t info;
+            mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+            kern_return_t result = thread_info( thread, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>( &info ), &count );
+            mach_port_deallocate( mach_task_self(), thread );
+            if( result != KERN_SUCCESS )
+                return 0;
+            return ( static_cast<uint64_t>( info.user_time.seconds ) + static_cast<uint64_t>( info.system_time.seconds ) ) * nanosecondsPerSecond
+                 + ( static_cast<uint64_t>( info.user_time.microseconds ) + static_cast<uint64_t>( info.system_time.microseconds ) ) * nanosecondsPerMicrosecond;
         }
 #else
-        uint64_t getCurrentTicks() {
-            timeval t;
-            gettimeofday(&t,CATCH_NULL);
-            return static_cast<uint64_t>( t.tv_sec ) * 1000000ull + static_cast<uint64_t>( t.tv_usec );
+        uint64_t toNanoseconds( timespec const& t ) {
+            return static_cast<uint64_t>( t.tv_sec ) * nanosecondsPerSecond + static_cast<uint64_t>( t.tv_nsec );
+        }
+        uint64_t getCurrentNanoseconds() {
+            timespec t;
+            clock_gettime( CLOCK_MONOTONIC, &t );
+            return toNanoseconds( t );
+        }
+        uint64_t getCurrentThreadCpuNanoseconds() {
+#  ifdef CLOCK_THREAD_CPUTIME_ID
+            timespec t;
+            clock_gettime( CLOCK_THREAD_CPUTIME_ID, &t );
+            return toNanoseconds( t );
+#  else
+            // No per-thread clock, so fall back to the whole process
+            return static_cast<uint64_t>( std::clock() ) * ( nanosecondsPerSecond / CLOCKS_PER_SEC );
+#  endif
         }
 #endif
+        uint64_t getCurrentNanoseconds( TimerClock::Type clock ) {
+            return clock == TimerClock::ThreadCpu
+                ? getCurrentThreadCpuNanoseconds()
+                : getCurrentNanoseconds();
+        }
+    }
+
+#ifdef CATCH_PLATFORM_WINDOWS
+    uint64_t getWallClockNanoseconds() {
+        FILETIME now;
+        GetSystemTimeAsFileTime( &now );
+        uint64_t intervals = ( static_cast<uint64_t>( now.dwHighDateTime ) << 32 ) | now.dwLowDateTime;
+        // FILETIMEs count 100ns intervals from 1601
+        uint64_t const intervalsFrom1601To1970 = ( static_cast<uint64_t>( 0x019db1de ) << 32 ) | 0xd53e8000;
+        return ( intervals - intervalsFrom1601To1970 ) * 100;
+    }
+#elif defined(CATCH_PLATFORM_MAC)
+    uint64_t getWallClockNanoseconds() {
+        timeval now;
+        gettimeofday( &now, CATCH_NULL );
+        return static_cast<uint64_t>( now.tv_sec ) * nanosecondsPerSecond + static_cast<uint64_t>( now.tv_usec ) * nanosecondsPerMicrosecond;
+    }
+#else
+    uint64_t getWallClockNanoseconds() {
+        timespec now;
+        clock_gettime( CLOCK_REALTIME, &now );
+        return toNanoseconds( now );
+    }
+#endif
+
+    std::string durationToString( uint64_t nanoseconds ) {
+        std::ostringstream oss;
+        oss << nanoseconds / nanosecondsPerSecond << '.' << std::setfill( '0' ) << std::setw( 9 ) << nanoseconds % nanosecondsPerSecond;
+        return oss.str();
     }
 
     void Timer::start() {
-        m_ticks = getCurrentTicks();
+        m_nanoseconds = getCurrentNanoseconds( m_clock );
+    }
+    uint64_t Timer::getElapsedNanoseconds() const {
+        return getCurrentNanoseconds( m_clock ) - m_nanoseconds;
     }
-    unsigned int Timer::getElapsedMicroseconds() const {
-        return static_cast<unsigned int>(getCurrentTicks() - m_ticks);
+    uint64_t Timer::getElapsedMicroseconds() const {
+        return getElapsedNanoseconds()/1000;
     }
-    unsigned int Timer::getElapsedMilliseconds() const {
-        return static_cast<unsigned int>(getElapsedMicroseconds()/1000);
+    uint64_t Timer::getElapsedMilliseconds() const {
+        return getElapsedNanoseconds()/1000000;
     }
     double Timer::getElapsedSeconds() const {
-        return getElapsedMicroseconds()/1000000.0;
+        return static_cast<double>( getElapsedNanoseconds() )/1000000000.0;
     }
 
 } // namespace Catch
@@ -7798,13 +12175,15 @@ namespace Catch {
 // #included from: catch_common.hpp
 #define TWOBLUECUBES_CATCH_COMMON_HPP_INCLUDED
 
+#include <cstring>
+
 namespace Catch {
 
     bool startsWith( std::string const& s, std::string const& prefix ) {
-        return s.size() >= prefix.size() && s.substr( 0, prefix.size() ) == prefix;
+        return s.size() >= prefix.size() && s.compare( 0, prefix.size(), prefix ) == 0;
     }
     bool endsWith( std::string const& s, std::string const& suffix ) {
-        return s.size() >= suffix.size() && s.substr( s.size()-suffix.size(), suffix.size() ) == suffix;
+        return s.size() >= suffix.size() && s.compare( s.size()-suffix.size(), suffix.size(), suffix ) == 0;
     }
     bool contains( std::string const& s, std::string const& infix ) {
         return s.find( infix ) != std::string::npos;
@@ -7839,6 +12218,43 @@ namespace Catch {
         return replaced;
     }
 
+    std::string escapeLineField( std::string const& field ) {
+        std::string escaped;
+        escaped.reserve( field.size() );
+        for( std::size_t i = 0; i < field.size(); ++i ) {
+            switch( field[i] ) {
+                case '\\': escaped += "\\\\"; break;
+                case '\t': escaped += "\\t"; break;
+                case '\n': escaped += "\\n"; break;
+                default: escaped += field[i]; break;
+            }
+        }
+        return escaped;
+    }
+    std::string unescapeLineField( std::string const& field ) {
+        std::string unescaped;
+        unescaped.reserve( field.size() );
+        for( std::size_t i = 0; i < field.size(); ++i ) {
+            if( field[i] == '\\' && i+1 < field.size() ) {
+                char c = field[++i];
+                unescaped += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+            }
+            else
+                unescaped += field[i];
+        }
+        return unescaped;
+    }
+    std::vector<std::string> splitLineFields( std::string const& line ) {
+        std::vector<std::string> fields;
+        for( std::string::size_type start = 0;; ) {
+            std::string::size_type tab = line.find( '\t', start );
+            fields.push_back( line.substr( start, tab == std::string::npos ? std::string::npos : tab - start ) );
+            if( tab == std::string::npos )
+                return fields;
+            start = tab + 1;
+        }
+    }
+
     pluralise::pluralise( std::size_t count, std::string const& label )
     :   m_count( count ),
         m_label( label )
@@ -7851,7 +12267,7 @@ namespace Catch {
         return os;
     }
 
-    SourceLineInfo::SourceLineInfo() : line( 0 ){}
+    SourceLineInfo::SourceLineInfo() : file( "" ), line( 0 ){}
     SourceLineInfo::SourceLineInfo( char const* _file, std::size_t _line )
     :   file( _file ),
         line( _line )
@@ -7861,13 +12277,13 @@ namespace Catch {
         line( other.line )
     {}
     bool SourceLineInfo::empty() const {
-        return file.empty();
+        return *file == '\0';
     }
     bool SourceLineInfo::operator == ( SourceLineInfo const& other ) const {
-        return line == other.line && file == other.file;
+        return line == other.line && ( file == other.file || std::strcmp( file, other.file ) == 0 );
     }
     bool SourceLineInfo::operator < ( SourceLineInfo const& other ) const {
-        return line < other.line || ( line == other.line  && file < other.file );
+        return line < other.line || ( line == other.line && std::strcmp( file, other.file ) < 0 );
     }
 
     void seedRng( IConfig const& config ) {
@@ -7878,57 +12294,425 @@ namespace Catch {
         return getCurrentContext().getConfig()->rngSeed();
     }
 
-    std::ostream& operator << ( std::ostream& os, SourceLineInfo const& info ) {
-#ifndef __GNUG__
-        os << info.file << "(" << info.line << ")";
-#else
-        os << info.file << ":" << info.line;
-#endif
-        return os;
-    }
+    std::ostream& operator << ( std::ostream& os, SourceLineInfo const& info ) {
+#ifndef __GNUG__
+        os << info.file << "(" << info.line << ")";
+#else
+        os << info.file << ":" << info.line;
+#endif
+        return os;
+    }
+
+    void throwLogicError( std::string const& message, SourceLineInfo const& locationInfo ) {
+        std::ostringstream oss;
+        oss << locationInfo << ": Internal Catch error: '" << message << "'";
+        if( alwaysTrue() )
+            throw std::logic_error( oss.str() );
+    }
+}
+
+// #included from: catch_section.hpp
+#define TWOBLUECUBES_CATCH_SECTION_HPP_INCLUDED
+
+namespace Catch {
+
+    SectionInfo::SectionInfo
+        (   SourceLineInfo const& _lineInfo,
+            std::string const& _name,
+            std::string const& _description )
+    :   name( _name ),
+        description( _description ),
+        lineInfo( _lineInfo )
+    {}
+
+    // Every SECTION met on a cycle gets here, though at most one is entered,
+    // so the info is only copied and the timer only set up for that one
+    Section::Section( SectionInfo const& info )
+    :   m_info( info.lineInfo, std::string() ),
+        m_sectionIncluded( getResultCapture().sectionStarted( info, m_assertions ) )
+    {
+        if( m_sectionIncluded ) {
+            m_info = info;
+            m_timer = Timer( getCurrentContext().getConfig()->timerClock() );
+            m_timer.start();
+        }
+    }
+
+    Section::~Section() {
+        if( m_sectionIncluded ) {
+            SectionEndInfo endInfo( m_info, m_assertions, m_timer.getElapsedNanoseconds() );
+            if( std::uncaught_exception() )
+                getResultCapture().sectionEndedEarly( endInfo );
+            else
+                getResultCapture().sectionEnded( endInfo );
+        }
+    }
+
+    // This indicates whether the section should be executed or not
+    Section::operator bool() const {
+        return m_sectionIncluded;
+    }
+
+} // end namespace Catch
+
+// #included from: catch_benchmark.hpp
+#define TWOBLUECUBES_CATCH_BENCHMARK_HPP_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace Catch {
+
+    namespace {
+        // The average gap between distinct readings of the clock. It only
+        // depends on the clock, so it is measured once per clock and kept
+        uint64_t estimateClockResolution( TimerClock::Type clock ) {
+            static uint64_t resolutions[2] = { 0, 0 };
+            uint64_t& resolution = resolutions[clock == TimerClock::ThreadCpu ? 1 : 0];
+            if( resolution == 0 ) {
+                const int ticks = 16;
+                uint64_t total = 0;
+                uint64_t last = getCurrentNanoseconds( clock );
+                for( int i = 0; i < ticks; ++i ) {
+                    uint64_t now;
+                    do {
+                        now = getCurrentNanoseconds( clock );
+                    } while( now == last );
+                    total += now - last;
+                    last = now;
+                }
+                resolution = std::max<uint64_t>( total / ticks, 1 );
+            }
+            return resolution;
+        }
+    }
+
+    double quantile( std::vector<double> const& sorted, double q ) {
+        double index = q * static_cast<double>( sorted.size() - 1 );
+        std::size_t lower = static_cast<std::size_t>( index );
+        if( lower + 1 >= sorted.size() )
+            return sorted.back();
+        double fraction = index - static_cast<double>( lower );
+        return sorted[lower] + fraction * ( sorted[lower+1] - sorted[lower] );
+    }
+
+    std::string nanosecondsToString( double nanoseconds ) {
+        static char const* const units[] = { "ns", "us", "ms", "s" };
+        std::size_t unit = 0;
+        while( unit < 3 && std::fabs( nanoseconds ) >= 1000.0 ) {
+            nanoseconds /= 1000.0;
+            ++unit;
+        }
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision( 3 ) << nanoseconds << ' ' << units[unit];
+        return oss.str();
+    }
+
+    BenchmarkStats::BenchmarkStats( BenchmarkInfo const& _info,
+                                    uint64_t _iterationsPerSample,
+                                    std::vector<double> const& _samples )
+    :   info( _info ),
+        iterationsPerSample( _iterationsPerSample ),
+        samples( _samples ),
+        mean( 0 ),
+        median( 0 ),
+        standardDeviation( 0 ),
+        min( 0 ),
+        max( 0 )
+    {
+        if( samples.empty() )
+            return;
+
+        std::vector<double> sorted( samples );
+        std::sort( sorted.begin(), sorted.end() );
+        min = sorted.front();
+        max = sorted.back();
+        median = quantile( sorted, 0.5 );
+
+        double sum = 0;
+        for( std::size_t i = 0; i < sorted.size(); ++i )
+            sum += sorted[i];
+        mean = sum / static_cast<double>( sorted.size() );
+
+        if( sorted.size() > 1 ) {
+            double squares = 0;
+            for( std::size_t i = 0; i < sorted.size(); ++i )
+                squares += ( sorted[i] - mean ) * ( sorted[i] - mean );
+            standardDeviation = std::sqrt( squares / static_cast<double>( sorted.size() - 1 ) );
+        }
+
+        double q1 = quantile( sorted, 0.25 );
+        double q3 = quantile( sorted, 0.75 );
+        double iqr = q3 - q1;
+        for( std::size_t i = 0; i < sorted.size(); ++i ) {
+            double sample = sorted[i];
+            if( sample < q1 - 3 * iqr )
+                ++outliers.lowSevere;
+            else if( sample < q1 - 1.5 * iqr )
+                ++outliers.lowMild;
+            else if( sample > q3 + 3 * iqr )
+                ++outliers.highSevere;
+            else if( sample > q3 + 1.5 * iqr )
+                ++outliers.highMild;
+        }
+    }
+
+    namespace {
+        // Resampling has its own generator so it doesn't disturb the
+        // sequence that --rng-seed gives the tests themselves
+        class XorShiftRng {
+        public:
+            explicit XorShiftRng( uint64_t seed ) : m_state( seed ) {}
+            uint64_t operator()() {
+                m_state ^= m_state << 13;
+                m_state ^= m_state >> 7;
+                m_state ^= m_state << 17;
+                return m_state;
+            }
+        private:
+            uint64_t m_state;
+        };
+
+        double medianOf( std::vector<double> samples ) {
+            std::sort( samples.begin(), samples.end() );
+            return quantile( samples, 0.5 );
+        }
+        double resampledMedian( std::vector<double> const& samples, std::vector<double>& scratch, XorShiftRng& rng ) {
+            scratch.resize( samples.size() );
+            for( std::size_t i = 0; i < scratch.size(); ++i )
+                scratch[i] = samples[static_cast<std::size_t>( rng() % samples.size() )];
+            std::nth_element( scratch.begin(), scratch.begin() + scratch.size()/2, scratch.end() );
+            return scratch[scratch.size()/2];
+        }
+
+        char const* const baselineHeader = "catch-benchmark-baseline 1";
+    }
+
+    BenchmarkComparison compareBenchmarkSamples( std::vector<double> const& baseline,
+                                                 std::vector<double> const& current,
+                                                 std::size_t resamples ) {
+        BenchmarkComparison comparison;
+        if( baseline.empty() || current.empty() )
+            return comparison;
+
+        double baselineMedian = medianOf( baseline );
+        if( baselineMedian <= 0 )
+            return comparison;
+        comparison.change = medianOf( current ) / baselineMedian - 1;
+        comparison.lowerBound = comparison.upperBound = comparison.change;
+
+        XorShiftRng rng( ( static_cast<uint64_t>( 0x9e3779b9 ) << 32 ) | 0x7f4a7c15 );
+        std::vector<double> scratch;
+        std::vector<double> changes;
+        changes.reserve( resamples );
+        for( std::size_t i = 0; i < resamples; ++i ) {
+            double resampledBaseline = resampledMedian( baseline, scratch, rng );
+            double resampledCurrent = resampledMedian( current, scratch, rng );
+            if( resampledBaseline > 0 )
+                changes.push_back( resampledCurrent / resampledBaseline - 1 );
+        }
+        if( !changes.empty() ) {
+            std::sort( changes.begin(), changes.end() );
+            comparison.lowerBound = quantile( changes, 0.025 );
+            comparison.upperBound = quantile( changes, 0.975 );
+        }
+        return comparison;
+    }
+
+    void BenchmarkBaseline::add( std::string const& testName, BenchmarkStats const& stats ) {
+        std::vector<double>& samples = m_samples[std::make_pair( testName, stats.info.name )];
+        samples.insert( samples.end(), stats.samples.begin(), stats.samples.end() );
+    }
+
+    std::vector<double> const* BenchmarkBaseline::find( std::string const& testName, std::string const& benchmarkName ) const {
+        Samples::const_iterator it = m_samples.find( std::make_pair( testName, benchmarkName ) );
+        return it == m_samples.end() ? CATCH_NULL : &it->second;
+    }
+
+    // One line per benchmark: test name, benchmark name, sample count and
+    // the samples, separated by tabs
+    void BenchmarkBaseline::load( std::string const& filename ) {
+        std::ifstream f( filename.c_str() );
+        std::string line;
+        if( !f || !std::getline( f, line ) || line != baselineHeader )
+            throw std::domain_error( "Unable to load benchmark baseline file: " + filename );
+
+        while( std::getline( f, line ) ) {
+            if( line.empty() )
+                continue;
+            std::vector<std::string> fields = splitLineFields( line );
+
+            std::size_t count = 0;
+            std::vector<double> samples;
+            if( fields.size() == 4 ) {
+                std::istringstream iss( fields[2] + " " + fields[3] );
+                double sample;
+                if( iss >> count )
+                    while( iss >> sample )
+                        samples.push_back( sample );
+            }
+            if( samples.empty() || samples.size() != count )
+                throw std::domain_error( "Corrupt benchmark baseline file: " + filename );
+
+            std::vector<double>& existing = m_samples[std::make_pair( unescapeLineField( fields[0] ), unescapeLineField( fields[1] ) )];
+            existing.insert( existing.end(), samples.begin(), samples.end() );
+        }
+    }
+
+    void BenchmarkBaseline::save( std::string const& filename ) const {
+        std::ofstream f( filename.c_str() );
+        if( !f )
+            throw std::domain_error( "Unable to write benchmark baseline file: " + filename );
+
+        f << baselineHeader << "\n" << std::setprecision( 17 );
+        for( Samples::const_iterator it = m_samples.begin(), itEnd = m_samples.end();
+                it != itEnd;
+                ++it ) {
+            f << escapeLineField( it->first.first ) << '\t'
+              << escapeLineField( it->first.second ) << '\t'
+              << it->second.size() << '\t';
+            for( std::size_t i = 0; i < it->second.size(); ++i )
+                f << ( i > 0 ? " " : "" ) << it->second[i];
+            f << "\n";
+        }
+        if( !f )
+            throw std::domain_error( "Unable to write benchmark baseline file: " + filename );
+    }
+
+    BenchmarkLooper::BenchmarkLooper( std::string const& name, SourceLineInfo const& lineInfo )
+    :   m_info( name, lineInfo ),
+        m_timer( getCurrentContext().getConfig()->timerClock() ),
+        m_batchSize( 1 ),
+        m_remaining( 1 ),
+        m_warmingUp( true ),
+        m_warmupNanoseconds( static_cast<uint64_t>( getCurrentContext().getConfig()->benchmarkWarmupTime() ) * 1000000 ),
+        m_warmupElapsed( 0 ),
+        m_sampleCount( static_cast<std::size_t>( getCurrentContext().getConfig()->benchmarkSamples() ) )
+    {
+        m_timer.start();
+    }
+
+    // Called each time a batch of iterations has run out
+    bool BenchmarkLooper::nextBatch() {
+        uint64_t elapsed = m_timer.getElapsedNanoseconds();
+        if( m_warmingUp ) {
+            m_warmupElapsed += elapsed;
+
+            // Keep doubling the batch until the warmup time is up and a batch
+            // lasts long enough to give a usable estimate of one iteration
+            TimerClock::Type clock = getCurrentContext().getConfig()->timerClock();
+            uint64_t resolution = estimateClockResolution( clock );
+            if( m_warmupElapsed < m_warmupNanoseconds || elapsed < resolution * 100 ) {
+                m_batchSize *= 2;
+            }
+            else {
+                // Each sample should span enough ticks that the clock's own
+                // granularity is lost in the noise
+                double nanosecondsPerIteration = static_cast<double>( elapsed ) / static_cast<double>( m_batchSize );
+                double iterations = std::ceil( static_cast<double>( resolution * 1000 ) / nanosecondsPerIteration );
+                m_batchSize = std::max<uint64_t>( static_cast<uint64_t>( iterations ), 1 );
+                m_warmingUp = false;
+                m_samples.reserve( m_sampleCount );
+            }
+        }
+        else {
+            m_samples.push_back( static_cast<double>( elapsed ) / static_cast<double>( m_batchSize ) );
+            if( m_samples.size() >= m_sampleCount ) {
+                getResultCapture().benchmarkEnded( BenchmarkStats( m_info, m_batchSize, m_samples ) );
+                return false;
+            }
+        }
+        m_remaining = m_batchSize;
+        m_timer.start();
+        return true;
+    }
+
+} // end namespace Catch
 
-    void throwLogicError( std::string const& message, SourceLineInfo const& locationInfo ) {
-        std::ostringstream oss;
-        oss << locationInfo << ": Internal Catch error: '" << message << "'";
-        if( alwaysTrue() )
-            throw std::logic_error( oss.str() );
-    }
-}
+// #included from: catch_test_durations.hpp
+#define TWOBLUECUBES_CATCH_TEST_DURATIONS_HPP_INCLUDED
 
-// #included from: catch_section.hpp
-#define TWOBLUECUBES_CATCH_SECTION_HPP_INCLUDED
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 namespace Catch {
 
-    SectionInfo::SectionInfo
-        (   SourceLineInfo const& _lineInfo,
-            std::string const& _name,
-            std::string const& _description )
-    :   name( _name ),
-        description( _description ),
-        lineInfo( _lineInfo )
-    {}
+    namespace {
+        char const* const durationsHeader = "catch-test-durations 1";
+    }
 
-    Section::Section( SectionInfo const& info )
-    :   m_info( info ),
-        m_sectionIncluded( getResultCapture().sectionStarted( m_info, m_assertions ) )
-    {
-        m_timer.start();
+    void TestDurations::set( std::string const& testName, uint64_t nanoseconds ) {
+        m_nanoseconds[testName] = nanoseconds;
     }
 
-    Section::~Section() {
-        if( m_sectionIncluded ) {
-            SectionEndInfo endInfo( m_info, m_assertions, m_timer.getElapsedSeconds() );
-            if( std::uncaught_exception() )
-                getResultCapture().sectionEndedEarly( endInfo );
-            else
-                getResultCapture().sectionEnded( endInfo );
+    void TestDurations::merge( TestDurations const& newer ) {
+        for( std::map<std::string, uint64_t>::const_iterator it = newer.m_nanoseconds.begin(), itEnd = newer.m_nanoseconds.end();
+                it != itEnd;
+                ++it )
+            m_nanoseconds[it->first] = it->second;
+    }
+
+    uint64_t const* TestDurations::find( std::string const& testName ) const {
+        std::map<std::string, uint64_t>::const_iterator it = m_nanoseconds.find( testName );
+        return it == m_nanoseconds.end() ? CATCH_NULL : &it->second;
+    }
+
+    // One line per test case: its name and duration in nanoseconds,
+    // separated by a tab
+    bool TestDurations::load( std::string const& filename ) {
+        std::ifstream f( filename.c_str() );
+        if( !f )
+            return false;
+
+        std::string line;
+        if( !std::getline( f, line ) || line != durationsHeader )
+            throw std::domain_error( "Unable to load test durations file: " + filename );
+
+        while( std::getline( f, line ) ) {
+            if( line.empty() )
+                continue;
+            std::vector<std::string> fields = splitLineFields( line );
+            uint64_t nanoseconds = 0;
+            if( fields.size() == 2 ) {
+                std::istringstream iss( fields[1] );
+                if( iss >> nanoseconds ) {
+                    m_nanoseconds[unescapeLineField( fields[0] )] = nanoseconds;
+                    continue;
+                }
+            }
+            throw std::domain_error( "Corrupt test durations file: " + filename );
         }
+        return true;
     }
 
-    // This indicates whether the section should be executed or not
-    Section::operator bool() const {
-        return m_sectionIncluded;
+    // Written aside and renamed into place, so a run that is killed part way
+    // through never leaves a truncated file behind
+    void TestDurations::save( std::string const& filename ) const {
+        std::string partFilename = filename + ".part";
+        {
+            std::ofstream f( partFilename.c_str() );
+            f << durationsHeader << "\n";
+            for( std::map<std::string, uint64_t>::const_iterator it = m_nanoseconds.begin(), itEnd = m_nanoseconds.end();
+                    it != itEnd;
+                    ++it )
+                f << escapeLineField( it->first ) << '\t' << it->second << "\n";
+            if( !f )
+                throw std::domain_error( "Unable to write test durations file: " + filename );
+        }
+#ifdef CATCH_PLATFORM_WINDOWS
+        // rename() won't replace an existing file on Windows
+        bool moved = MoveFileExA( partFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+        bool moved = std::rename( partFilename.c_str(), filename.c_str() ) == 0;
+#endif
+        if( !moved )
+            throw std::domain_error( "Unable to write test durations file: " + filename );
     }
 
 } // end namespace Catch
@@ -8025,6 +12809,10 @@ namespace Catch {
 // #included from: catch_tostring.hpp
 #define TWOBLUECUBES_CATCH_TOSTRING_HPP_INCLUDED
 
+#include <stdio.h>
+#include <clocale>
+#include <limits>
+
 namespace Catch {
 
 namespace Detail {
@@ -8034,6 +12822,31 @@ namespace Detail {
     namespace {
         const int hexThreshold = 255;
 
+        // Numbers are formatted into a buffer on the stack rather than
+        // through a stream, which is costly to build for every value of,
+        // say, a large container in a failure's expansion
+        template<typename UnsignedT>
+        std::string integerToString( UnsignedT magnitude, bool negative ) {
+            char buffer[2 * std::numeric_limits<UnsignedT>::digits10 + 24];
+            char* const end = buffer + sizeof( buffer );
+            char* p = end;
+            if( !negative && magnitude > static_cast<UnsignedT>( hexThreshold ) ) {
+                *--p = ')';
+                for( UnsignedT digits = magnitude; digits != 0; digits /= 16 )
+                    *--p = "0123456789abcdef"[digits % 16];
+                p -= 4;
+                std::memcpy( p, " (0x", 4 );
+            }
+            UnsignedT digits = magnitude;
+            do {
+                *--p = static_cast<char>( '0' + digits % 10 );
+                digits /= 10;
+            } while( digits != 0 );
+            if( negative )
+                *--p = '-';
+            return std::string( p, end );
+        }
+
         struct Endianness {
             enum Arch { Big, Little };
 
@@ -8049,6 +12862,16 @@ namespace Detail {
         };
     }
 
+    // Without a config, as when used outside of a test run, nothing is left out
+    std::size_t containerLimit() {
+        Ptr<IConfig const> config = getCurrentContext().getConfig();
+        return config ? config->containerLimit() : 0;
+    }
+    std::size_t diffContext() {
+        Ptr<IConfig const> config = getCurrentContext().getConfig();
+        return config ? config->diffContext() : 5;
+    }
+
     std::string rawMemoryToString( const void *object, std::size_t size )
     {
         // Reverse order for little endian architectures
@@ -8113,19 +12936,12 @@ std::string toString( wchar_t* const value )
 }
 
 std::string toString( int value ) {
-    std::ostringstream oss;
-    oss << value;
-    if( value > Detail::hexThreshold )
-        oss << " (0x" << std::hex << value << ")";
-    return oss.str();
+    unsigned int magnitude = static_cast<unsigned int>( value );
+    return Detail::integerToString( value < 0 ? 0u - magnitude : magnitude, value < 0 );
 }
 
 std::string toString( unsigned long value ) {
-    std::ostringstream oss;
-    oss << value;
-    if( value > Detail::hexThreshold )
-        oss << " (0x" << std::hex << value << ")";
-    return oss.str();
+    return Detail::integerToString( value, false );
 }
 
 std::string toString( unsigned int value ) {
@@ -8134,18 +12950,38 @@ std::string toString( unsigned int value ) {
 
 template<typename T>
 std::string fpToString( T value, int precision ) {
-    std::ostringstream oss;
-    oss << std::setprecision( precision )
-        << std::fixed
-        << value;
-    std::string d = oss.str();
-    std::size_t i = d.find_last_not_of( '0' );
-    if( i != std::string::npos && i != d.size()-1 ) {
-        if( d[i] == '.' )
+    // The stream's fixed notation is defined in terms of printf's %f, so
+    // this formats just as it did, without building a stream for it
+    char buffer[std::numeric_limits<double>::max_exponent10 + 64];
+#if defined(_MSC_VER) && _MSC_VER < 1900
+    int length = _snprintf( buffer, sizeof( buffer ), "%.*f", precision, static_cast<double>( value ) );
+#else
+    int length = snprintf( buffer, sizeof( buffer ), "%.*f", precision, static_cast<double>( value ) );
+#endif
+    if( length <= 0 || static_cast<std::size_t>( length ) >= sizeof( buffer ) )
+        return Detail::unprintableString;
+
+    std::size_t size = static_cast<std::size_t>( length );
+    // The stream used its own, classic, locale, but snprintf writes the
+    // decimal point of whatever C locale the program has set with setlocale
+    char const* point = std::localeconv()->decimal_point;
+    if( point[0] != '\0' && ( point[0] != '.' || point[1] != '\0' ) ) {
+        if( char* found = std::strstr( buffer, point ) ) {
+            std::size_t pointLength = std::strlen( point );
+            *found = '.';
+            std::memmove( found + 1, found + pointLength, size - static_cast<std::size_t>( found - buffer ) - pointLength + 1 );
+            size -= pointLength - 1;
+        }
+    }
+    std::size_t i = size;
+    while( i > 0 && buffer[i-1] == '0' )
+        --i;
+    if( i > 0 && i != size ) {
+        if( buffer[i-1] == '.' )
             i++;
-        d = d.substr( 0, i+1 );
+        size = i;
     }
-    return d;
+    return std::string( buffer, size );
 }
 
 std::string toString( const double value ) {
@@ -8175,18 +13011,11 @@ std::string toString( unsigned char value ) {
 
 #ifdef CATCH_CONFIG_CPP11_LONG_LONG
 std::string toString( long long value ) {
-    std::ostringstream oss;
-    oss << value;
-    if( value > Detail::hexThreshold )
-        oss << " (0x" << std::hex << value << ")";
-    return oss.str();
+    unsigned long long magnitude = static_cast<unsigned long long>( value );
+    return Detail::integerToString( value < 0 ? 0ull - magnitude : magnitude, value < 0 );
 }
 std::string toString( unsigned long long value ) {
-    std::ostringstream oss;
-    oss << value;
-    if( value > Detail::hexThreshold )
-        oss << " (0x" << std::hex << value << ")";
-    return oss.str();
+    return Detail::integerToString( value, false );
 }
 #endif
 
@@ -8229,7 +13058,11 @@ namespace Catch {
                                     char const* capturedExpression,
                                     ResultDisposition::Flags resultDisposition,
                                     char const* secondArg )
-    :   m_assertionInfo( macroName, lineInfo, capturedExpressionWithSecondArgument( capturedExpression, secondArg ), resultDisposition ),
+    :   m_macroName( macroName ),
+        m_lineInfo( lineInfo ),
+        m_capturedExpression( capturedExpression ),
+        m_secondArg( secondArg ),
+        m_resultDisposition( resultDisposition ),
         m_shouldDebugBreak( false ),
         m_shouldThrow( false )
     {}
@@ -8256,13 +13089,25 @@ namespace Catch {
     }
 
     void ResultBuilder::endExpression() {
-        m_exprComponents.testFalse = isFalseTest( m_assertionInfo.resultDisposition );
+        m_exprComponents.testFalse = isFalseTest( m_resultDisposition );
         captureExpression();
     }
 
+    // Stringifying the operands is often the most expensive part of an
+    // assertion, so it is only done when the result type set so far means a
+    // reporter will show it. Without the operands the result falls back to the
+    // expression as written
+    bool ResultBuilder::shouldExpand() const {
+        bool passed = ( m_data.resultType == ResultWas::Ok ) != isFalseTest( m_resultDisposition );
+        if( !passed )
+            return true;
+        IResultCapture* capture = getCurrentContext().getResultCapture();
+        return !capture || capture->reportsPassingAssertions();
+    }
+
     void ResultBuilder::useActiveException( ResultDisposition::Flags resultDisposition ) {
-        m_assertionInfo.resultDisposition = resultDisposition;
-        m_stream.oss << Catch::translateActiveException();
+        m_resultDisposition = resultDisposition;
+        m_stream.stream() << Catch::translateActiveException();
         captureResult( ResultWas::ThrewException );
     }
 
@@ -8282,18 +13127,23 @@ namespace Catch {
         assert( m_exprComponents.testFalse == false );
         AssertionResultData data = m_data;
         data.resultType = ResultWas::Ok;
-        data.reconstructedExpression = m_assertionInfo.capturedExpression;
+        data.reconstructedExpression = capturedExpressionWithSecondArgument( m_capturedExpression, m_secondArg );
 
         std::string actualMessage = Catch::translateActiveException();
         if( !matcher.match( actualMessage ) ) {
             data.resultType = ResultWas::ExpressionFailed;
             data.reconstructedExpression = actualMessage;
         }
-        AssertionResult result( m_assertionInfo, data );
+        AssertionResult result( assertionInfo(), data );
         handleResult( result );
     }
 
     void ResultBuilder::captureExpression() {
+        if( !shouldExpand() ) {
+            // Passed, and no reporter will show it, so there's nothing to build
+            getResultCapture().assertionPassed();
+            return;
+        }
         AssertionResult result = build();
         handleResult( result );
     }
@@ -8304,7 +13154,7 @@ namespace Catch {
         if( !result.isOk() ) {
             if( getCurrentContext().getConfig()->shouldDebugBreak() )
                 m_shouldDebugBreak = true;
-            if( getCurrentContext().getRunner()->aborting() || (m_assertionInfo.resultDisposition & ResultDisposition::Normal) )
+            if( getCurrentContext().getRunner()->aborting() || (m_resultDisposition & ResultDisposition::Normal) )
                 m_shouldThrow = true;
         }
     }
@@ -8330,7 +13180,7 @@ namespace Catch {
                 data.resultType = ResultWas::Ok;
         }
 
-        data.message = m_stream.oss.str();
+        data.message = m_stream.str();
         data.reconstructedExpression = reconstructExpression();
         if( m_exprComponents.testFalse ) {
             if( m_exprComponents.op == "" )
@@ -8338,11 +13188,16 @@ namespace Catch {
             else
                 data.reconstructedExpression = "!(" + data.reconstructedExpression + ")";
         }
-        return AssertionResult( m_assertionInfo, data );
+        return AssertionResult( assertionInfo(), data );
+    }
+    AssertionInfo ResultBuilder::assertionInfo() const {
+        return AssertionInfo( m_macroName, m_lineInfo, capturedExpressionWithSecondArgument( m_capturedExpression, m_secondArg ), m_resultDisposition );
     }
     std::string ResultBuilder::reconstructExpression() const {
+        std::string capturedExpression = capturedExpressionWithSecondArgument( m_capturedExpression, m_secondArg );
+        std::string macroName = m_macroName;
         if( m_exprComponents.op == "" )
-            return m_exprComponents.lhs.empty() ? m_assertionInfo.capturedExpression : m_exprComponents.op + m_exprComponents.lhs;
+            return m_exprComponents.lhs.empty() ? capturedExpression : m_exprComponents.op + m_exprComponents.lhs;
         else if( m_exprComponents.op == "matches" )
             return m_exprComponents.lhs + " " + m_exprComponents.rhs;
         else if( m_exprComponents.op != "!" ) {
@@ -8354,7 +13209,7 @@ namespace Catch {
                 return m_exprComponents.lhs + "\n" + m_exprComponents.op + "\n" + m_exprComponents.rhs;
         }
         else
-            return "{can't expand - use " + m_assertionInfo.macroName + "_FALSE( " + m_assertionInfo.capturedExpression.substr(1) + " ) instead of " + m_assertionInfo.macroName + "( " + m_assertionInfo.capturedExpression + " ) for better diagnostics}";
+            return "{can't expand - use " + macroName + "_FALSE( " + capturedExpression.substr(1) + " ) instead of " + macroName + "( " + capturedExpression + " ) for better diagnostics}";
     }
 
 } // end namespace Catch
@@ -8468,7 +13323,12 @@ public:
 public: // IStreamingReporter
 
     virtual ReporterPreferences getPreferences() const CATCH_OVERRIDE {
-        return m_reporters[0]->getPreferences();
+        ReporterPreferences prefs = m_reporters[0]->getPreferences();
+        for( Reporters::const_iterator it = m_reporters.begin()+1, itEnd = m_reporters.end();
+                it != itEnd;
+                ++it )
+            prefs.shouldReportAllAssertions = prefs.shouldReportAllAssertions || (*it)->getPreferences().shouldReportAllAssertions;
+        return prefs;
     }
 
     virtual void noMatchingTestCases( std::string const& spec ) CATCH_OVERRIDE {
@@ -8523,6 +13383,13 @@ public: // IStreamingReporter
         return clearBuffer;
     }
 
+    virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+        for( Reporters::const_iterator it = m_reporters.begin(), itEnd = m_reporters.end();
+                it != itEnd;
+                ++it )
+            (*it)->benchmarkEnded( benchmarkStats );
+    }
+
     virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
         for( Reporters::const_iterator it = m_reporters.begin(), itEnd = m_reporters.end();
                 it != itEnd;
@@ -8628,6 +13495,8 @@ namespace Catch {
             m_sectionStack.push_back( _sectionInfo );
         }
 
+        virtual void benchmarkEnded( BenchmarkStats const& /* _benchmarkStats */ ) CATCH_OVERRIDE {}
+
         virtual void sectionEnded( SectionStats const& /* _sectionStats */ ) CATCH_OVERRIDE {
             m_sectionStack.pop_back();
         }
@@ -8683,8 +13552,13 @@ namespace Catch {
             SectionStats stats;
             typedef std::vector<Ptr<SectionNode> > ChildSections;
             typedef std::vector<AssertionStats> Assertions;
+            typedef std::vector<BenchmarkStats> Benchmarks;
             ChildSections childSections;
+            // Passing assertions are usually not reported, so they are only
+            // counted here, while the reported ones are kept in full
+            Counts directAssertions;
             Assertions assertions;
+            Benchmarks benchmarks;
             std::string stdOut;
             std::string stdErr;
         };
@@ -8743,6 +13617,7 @@ namespace Catch {
                     node = *it;
             }
             m_sectionStack.push_back( node );
+            m_nestedAssertions.push_back( Counts() );
             m_deepestSection = node;
         }
 
@@ -8754,11 +13629,19 @@ namespace Catch {
             sectionNode.assertions.push_back( assertionStats );
             return true;
         }
+        virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+            assert( !m_sectionStack.empty() );
+            m_sectionStack.back()->benchmarks.push_back( benchmarkStats );
+        }
         virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
             assert( !m_sectionStack.empty() );
             SectionNode& node = *m_sectionStack.back();
             node.stats = sectionStats;
+            node.directAssertions += sectionStats.assertions - m_nestedAssertions.back();
             m_sectionStack.pop_back();
+            m_nestedAssertions.pop_back();
+            if( !m_nestedAssertions.empty() )
+                m_nestedAssertions.back() += sectionStats.assertions;
         }
         virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
             Ptr<TestCaseNode> node = new TestCaseNode( testCaseStats );
@@ -8798,6 +13681,7 @@ namespace Catch {
         Ptr<SectionNode> m_rootSection;
         Ptr<SectionNode> m_deepestSection;
         std::vector<Ptr<SectionNode> > m_sectionStack;
+        std::vector<Counts> m_nestedAssertions;
         ReporterPreferences m_reporterPrefs;
 
     };
@@ -8920,6 +13804,11 @@ namespace Catch {
 #include <vector>
 #include <iomanip>
 
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#  define CATCH_INTERNAL_XML_ENCODE_SSE2
+#  include <emmintrin.h>
+#endif
+
 namespace Catch {
 
     class XmlEncode {
@@ -8932,38 +13821,49 @@ namespace Catch {
         {}
 
         void encodeTo( std::ostream& os ) const {
+            std::string encoded;
+            encodeTo( encoded, m_str, m_forWhat );
+            os << encoded;
+        }
+
+        // Appends str to out, escaped. Runs of characters that need no
+        // escaping are found 16 at a time where there is SSE2, and copied
+        // across in one go
+        static void encodeTo( std::string& out, std::string const& str, ForWhat forWhat ) {
 
             // Apostrophe escaping not necessary if we always use " to write attributes
             // (see: http://www.w3.org/TR/xml/#syntax)
 
-            for( std::size_t i = 0; i < m_str.size(); ++ i ) {
-                char c = m_str[i];
+            static char const hexDigits[] = "0123456789ABCDEF";
+            char const* data = str.data();
+            std::size_t size = str.size();
+            for( std::size_t i = 0; i < size; ++i ) {
+                std::size_t next = findSpecial( data, i, size, forWhat );
+                out.append( data + i, next - i );
+                if( next == size )
+                    break;
+                i = next;
+                char c = data[i];
                 switch( c ) {
-                    case '<':   os << "&lt;"; break;
-                    case '&':   os << "&amp;"; break;
+                    case '<':   out += "&lt;"; break;
+                    case '&':   out += "&amp;"; break;
+                    case '\"':  out += "&quot;"; break; // Only found in attributes
 
                     case '>':
                         // See: http://www.w3.org/TR/xml/#syntax
-                        if( i > 2 && m_str[i-1] == ']' && m_str[i-2] == ']' )
-                            os << "&gt;";
-                        else
-                            os << c;
-                        break;
-
-                    case '\"':
-                        if( m_forWhat == ForAttributes )
-                            os << "&quot;";
+                        if( i >= 2 && data[i-1] == ']' && data[i-2] == ']' )
+                            out += "&gt;";
                         else
-                            os << c;
+                            out += c;
                         break;
 
                     default:
                         // Escape control chars - based on contribution by @espenalb in PR #465 and
                         // by @mrpi PR #588
-                        if ( ( c < '\x09' ) || ( c > '\x0D' && c < '\x20') || c=='\x7F' )
-                            os << "&#x" << std::uppercase << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>( c ) << ';';
-                        else
-                            os << c;
+                        out += "&#x";
+                        out += hexDigits[( c >> 4 ) & 0xf];
+                        out += hexDigits[c & 0xf];
+                        out += ';';
                 }
             }
         }
@@ -8974,10 +13874,67 @@ namespace Catch {
         }
 
     private:
+        static bool isSpecial( char c, ForWhat forWhat ) {
+            switch( c ) {
+                case '<': case '&': case '>':
+                    return true;
+                case '\"':
+                    return forWhat == ForAttributes;
+                default:
+                    // Bytes from 0x80 up are left alone, as parts of UTF-8 sequences
+                    unsigned char u = static_cast<unsigned char>( c );
+                    return u < 0x09 || ( u > 0x0D && u < 0x20 ) || u == 0x7F;
+            }
+        }
+
+        // Returns the index of the first character from start on that may
+        // need escaping, or size if there are none. A '>' is only escaped
+        // after "]]", but it's rare enough to leave that to the caller
+        static std::size_t findSpecial( char const* data, std::size_t start, std::size_t size, ForWhat forWhat ) {
+            std::size_t i = start;
+#ifdef CATCH_INTERNAL_XML_ENCODE_SSE2
+            __m128i const lt = _mm_set1_epi8( '<' );
+            __m128i const amp = _mm_set1_epi8( '&' );
+            __m128i const gt = _mm_set1_epi8( '>' );
+            __m128i const quot = _mm_set1_epi8( forWhat == ForAttributes ? '\"' : '<' );
+            __m128i const del = _mm_set1_epi8( 0x7F );
+            __m128i const space = _mm_set1_epi8( 0x20 );
+            __m128i const minusOne = _mm_set1_epi8( -1 );
+            __m128i const backspace = _mm_set1_epi8( 0x08 );
+            __m128i const shiftOut = _mm_set1_epi8( 0x0E );
+            for( ; i + 16 <= size; i += 16 ) {
+                __m128i chars = _mm_loadu_si128( reinterpret_cast<__m128i const*>( data + i ) );
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128( _mm_cmpeq_epi8( chars, lt ), _mm_cmpeq_epi8( chars, amp ) ),
+                    _mm_or_si128( _mm_cmpeq_epi8( chars, gt ), _mm_cmpeq_epi8( chars, quot ) ) );
+                special = _mm_or_si128( special, _mm_cmpeq_epi8( chars, del ) );
+
+                // The comparisons are signed, so bytes from 0x80 up aren't controls
+                __m128i control = _mm_and_si128( _mm_cmplt_epi8( chars, space ), _mm_cmpgt_epi8( chars, minusOne ) );
+                __m128i whitespace = _mm_and_si128( _mm_cmpgt_epi8( chars, backspace ), _mm_cmplt_epi8( chars, shiftOut ) );
+                special = _mm_or_si128( special, _mm_andnot_si128( whitespace, control ) );
+
+                if( int mask = _mm_movemask_epi8( special ) ) {
+                    while( ( mask & 1 ) == 0 ) {
+                        mask >>= 1;
+                        ++i;
+                    }
+                    return i;
+                }
+            }
+#endif
+            for( ; i < size; ++i )
+                if( isSpecial( data[i], forWhat ) )
+                    return i;
+            return size;
+        }
+
         std::string m_str;
         ForWhat m_forWhat;
     };
 
+    // Output is built up in one buffer, which is written out to the stream
+    // as it fills, when the document is complete, and on flush() or setStream()
     class XmlWriter {
     public:
 
@@ -9020,7 +13977,11 @@ namespace Catch {
             // We encode control characters, which requires
             // XML 1.1
             // see http://stackoverflow.com/questions/404107/why-are-control-characters-illegal-in-xml-1-0
-            *m_os << "<?xml version=\"1.1\" encoding=\"UTF-8\"?>\n";
+            m_buffer.reserve( bufferSize );
+            m_buffer += "<?xml version=\"1.1\" encoding=\"UTF-8\"?>\n";
+            // Written out straight away, as a later setStream() may come while
+            // Catch::cout() is redirected - or from another thread, with --async-reporter
+            flush();
         }
 
         XmlWriter( std::ostream& os )
@@ -9028,18 +13989,22 @@ namespace Catch {
             m_needsNewline( false ),
             m_os( &os )
         {
-            *m_os << "<?xml version=\"1.1\" encoding=\"UTF-8\"?>\n";
+            m_buffer.reserve( bufferSize );
+            m_buffer += "<?xml version=\"1.1\" encoding=\"UTF-8\"?>\n";
         }
 
         ~XmlWriter() {
             while( !m_tags.empty() )
                 endElement();
+            flush();
         }
 
         XmlWriter& startElement( std::string const& name ) {
             ensureTagClosed();
             newlineIfNecessary();
-            stream() << m_indent << "<" << name;
+            m_buffer += m_indent;
+            m_buffer += '<';
+            m_buffer += name;
             m_tags.push_back( name );
             m_indent += "  ";
             m_tagIsOpen = true;
@@ -9054,26 +14019,40 @@ namespace Catch {
 
         XmlWriter& endElement() {
             newlineIfNecessary();
-            m_indent = m_indent.substr( 0, m_indent.size()-2 );
+            m_indent.resize( m_indent.size()-2 );
             if( m_tagIsOpen ) {
-                stream() << "/>\n";
+                m_buffer += "/>\n";
                 m_tagIsOpen = false;
             }
             else {
-                stream() << m_indent << "</" << m_tags.back() << ">\n";
+                m_buffer += m_indent;
+                m_buffer += "</";
+                m_buffer += m_tags.back();
+                m_buffer += ">\n";
             }
             m_tags.pop_back();
+            if( m_tags.empty() )
+                flush();
+            else
+                flushIfFull();
             return *this;
         }
 
         XmlWriter& writeAttribute( std::string const& name, std::string const& attribute ) {
-            if( !name.empty() && !attribute.empty() )
-                stream() << " " << name << "=\"" << XmlEncode( attribute, XmlEncode::ForAttributes ) << "\"";
+            if( !name.empty() && !attribute.empty() ) {
+                m_buffer += ' ';
+                m_buffer += name;
+                m_buffer += "=\"";
+                XmlEncode::encodeTo( m_buffer, attribute, XmlEncode::ForAttributes );
+                m_buffer += '\"';
+            }
             return *this;
         }
 
         XmlWriter& writeAttribute( std::string const& name, bool attribute ) {
-            stream() << " " << name << "=\"" << ( attribute ? "true" : "false" ) << "\"";
+            m_buffer += ' ';
+            m_buffer += name;
+            m_buffer += attribute ? "=\"true\"" : "=\"false\"";
             return *this;
         }
 
@@ -9089,48 +14068,63 @@ namespace Catch {
                 bool tagWasOpen = m_tagIsOpen;
                 ensureTagClosed();
                 if( tagWasOpen && indent )
-                    stream() << m_indent;
-                stream() << XmlEncode( text );
+                    m_buffer += m_indent;
+                XmlEncode::encodeTo( m_buffer, text, XmlEncode::ForTextNodes );
                 m_needsNewline = true;
+                flushIfFull();
             }
             return *this;
         }
 
         XmlWriter& writeComment( std::string const& text ) {
             ensureTagClosed();
-            stream() << m_indent << "<!--" << text << "-->";
+            m_buffer += m_indent;
+            m_buffer += "<!--";
+            m_buffer += text;
+            m_buffer += "-->";
             m_needsNewline = true;
             return *this;
         }
 
         XmlWriter& writeBlankLine() {
             ensureTagClosed();
-            stream() << "\n";
+            m_buffer += '\n';
             return *this;
         }
 
         void setStream( std::ostream& os ) {
+            flush();
             m_os = &os;
         }
 
+        void flush() {
+            if( !m_buffer.empty() ) {
+                m_os->write( m_buffer.data(), static_cast<std::streamsize>( m_buffer.size() ) );
+                m_buffer.clear();
+            }
+        }
+
     private:
         XmlWriter( XmlWriter const& );
         void operator=( XmlWriter const& );
 
-        std::ostream& stream() {
-            return *m_os;
+        static const std::size_t bufferSize = 64*1024;
+
+        void flushIfFull() {
+            if( m_buffer.size() >= bufferSize )
+                flush();
         }
 
         void ensureTagClosed() {
             if( m_tagIsOpen ) {
-                stream() << ">\n";
+                m_buffer += ">\n";
                 m_tagIsOpen = false;
             }
         }
 
         void newlineIfNecessary() {
             if( m_needsNewline ) {
-                stream() << "\n";
+                m_buffer += '\n';
                 m_needsNewline = false;
             }
         }
@@ -9140,6 +14134,7 @@ namespace Catch {
         std::vector<std::string> m_tags;
         std::string m_indent;
         std::ostream* m_os;
+        std::string m_buffer;
     };
 
 }
@@ -9197,9 +14192,6 @@ namespace Catch {
         virtual void testCaseStarting( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
             StreamingReporterBase::testCaseStarting(testInfo);
             m_xml.startElement( "TestCase" ).writeAttribute( "name", testInfo.name );
-
-            if ( m_config->showDurations() == ShowDurations::Always )
-                m_testCaseTimer.start();
         }
 
         virtual void sectionStarting( SectionInfo const& sectionInfo ) CATCH_OVERRIDE {
@@ -9284,6 +14276,26 @@ namespace Catch {
             return true;
         }
 
+        virtual void benchmarkEnded( BenchmarkStats const& benchmarkStats ) CATCH_OVERRIDE {
+            m_xml.startElement( "Benchmark" )
+                .writeAttribute( "name", benchmarkStats.info.name )
+                .writeAttribute( "filename", benchmarkStats.info.lineInfo.file )
+                .writeAttribute( "line", benchmarkStats.info.lineInfo.line )
+                .writeAttribute( "samples", benchmarkStats.samples.size() )
+                .writeAttribute( "iterations", benchmarkStats.iterationsPerSample )
+                .writeAttribute( "meanInNanoseconds", benchmarkStats.mean )
+                .writeAttribute( "medianInNanoseconds", benchmarkStats.median )
+                .writeAttribute( "standardDeviationInNanoseconds", benchmarkStats.standardDeviation )
+                .writeAttribute( "minInNanoseconds", benchmarkStats.min )
+                .writeAttribute( "maxInNanoseconds", benchmarkStats.max );
+            m_xml.scopedElement( "Outliers" )
+                .writeAttribute( "lowSevere", benchmarkStats.outliers.lowSevere )
+                .writeAttribute( "lowMild", benchmarkStats.outliers.lowMild )
+                .writeAttribute( "highMild", benchmarkStats.outliers.highMild )
+                .writeAttribute( "highSevere", benchmarkStats.outliers.highSevere );
+            m_xml.endElement();
+        }
+
         virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
             StreamingReporterBase::sectionEnded( sectionStats );
             if( --m_sectionDepth > 0 ) {
@@ -9293,7 +14305,7 @@ namespace Catch {
                 e.writeAttribute( "expectedFailures", sectionStats.assertions.failedButOk );
 
                 if ( m_config->showDurations() == ShowDurations::Always )
-                    e.writeAttribute( "durationInSeconds", sectionStats.durationInSeconds );
+                    e.writeAttribute( "durationInSeconds", durationToString( sectionStats.durationInNanoseconds ) );
 
                 m_xml.endElement();
             }
@@ -9305,7 +14317,7 @@ namespace Catch {
             e.writeAttribute( "success", testCaseStats.totals.assertions.allOk() );
 
             if ( m_config->showDurations() == ShowDurations::Always )
-                e.writeAttribute( "durationInSeconds", m_testCaseTimer.getElapsedSeconds() );
+                e.writeAttribute( "durationInSeconds", durationToString( testCaseStats.durationInNanoseconds ) );
 
             m_xml.endElement();
         }
@@ -9330,7 +14342,6 @@ namespace Catch {
         }
 
     private:
-        Timer m_testCaseTimer;
         XmlWriter m_xml;
         int m_sectionDepth;
     };
@@ -9350,7 +14361,9 @@ namespace Catch {
     public:
         JunitReporter( ReporterConfig const& _config )
         :   CumulativeReporterBase( _config ),
-            xml( _config.stream() )
+            xml( _config.stream() ),
+            suiteAttributesOffset( 0 ),
+            unexpectedExceptions( 0 )
         {
             m_reporterPrefs.shouldRedirectStdOut = true;
         }
@@ -9368,12 +14381,24 @@ namespace Catch {
             xml.startElement( "testsuites" );
         }
 
+        // A suite's counts go in its start tag but aren't known until it
+        // ends, so everything inside it is written to a temporary file as
+        // each test case ends, and copied out with the attributes spliced
+        // in once the suite is done. That keeps memory flat however many test
+        // cases there are, and still works when the output is a pipe
         virtual void testGroupStarting( GroupInfo const& groupInfo ) CATCH_OVERRIDE {
             suiteTimer.start();
-            stdOutForSuite.str("");
-            stdErrForSuite.str("");
+            suite.reset( new TempFileStream() );
+            stdOutForSuite.reset( new TempFileStream() );
+            stdErrForSuite.reset( new TempFileStream() );
             unexpectedExceptions = 0;
             CumulativeReporterBase::testGroupStarting( groupInfo );
+
+            xml.setStream( suite->stream() );
+            xml.startElement( "testsuite" );
+            xml.flush();
+            suiteAttributesOffset = suite->size();
+            xml.writeAttribute( "timestamp", "tbd" ); // !TBD
         }
 
         virtual bool assertionEnded( AssertionStats const& assertionStats ) CATCH_OVERRIDE {
@@ -9383,24 +14408,37 @@ namespace Catch {
         }
 
         virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
-            stdOutForSuite << testCaseStats.stdOut;
-            stdErrForSuite << testCaseStats.stdErr;
+            stdOutForSuite->stream() << testCaseStats.stdOut;
+            stdErrForSuite->stream() << testCaseStats.stdErr;
             CumulativeReporterBase::testCaseEnded( testCaseStats );
+            writeTestCase( *m_testCases.back() );
+            m_testCases.clear();
         }
 
         virtual void testGroupEnded( TestGroupStats const& testGroupStats ) CATCH_OVERRIDE {
-            double suiteTime = suiteTimer.getElapsedSeconds();
+            uint64_t suiteTime = suiteTimer.getElapsedNanoseconds();
             CumulativeReporterBase::testGroupEnded( testGroupStats );
-            writeGroup( *m_testGroups.back(), suiteTime );
+
+            writeSuiteOutput( "system-out", *stdOutForSuite );
+            writeSuiteOutput( "system-err", *stdErrForSuite );
+            xml.endElement();
+
+            xml.setStream( stream );
+            suite->copyTo( stream, 0, suiteAttributesOffset );
+            writeSuiteAttributes( testGroupStats, suiteTime );
+            xml.flush();
+            suite->copyTo( stream, suiteAttributesOffset, suite->size() );
+
+            suite.reset();
+            stdOutForSuite.reset();
+            stdErrForSuite.reset();
         }
 
         virtual void testRunEndedCumulative() CATCH_OVERRIDE {
             xml.endElement();
         }
 
-        void writeGroup( TestGroupNode const& groupNode, double suiteTime ) {
-            XmlWriter::ScopedElement e = xml.scopedElement( "testsuite" );
-            TestGroupStats const& stats = groupNode.value;
+        void writeSuiteAttributes( TestGroupStats const& stats, uint64_t suiteTime ) {
             xml.writeAttribute( "name", stats.groupInfo.name );
             xml.writeAttribute( "errors", unexpectedExceptions );
             xml.writeAttribute( "failures", stats.totals.assertions.failed-unexpectedExceptions );
@@ -9409,18 +14447,42 @@ namespace Catch {
             if( m_config->showDurations() == ShowDurations::Never )
                 xml.writeAttribute( "time", "" );
             else
-                xml.writeAttribute( "time", suiteTime );
-            xml.writeAttribute( "timestamp", "tbd" ); // !TBD
-
-            // Write test cases
-            for( TestGroupNode::ChildNodes::const_iterator
-                    it = groupNode.children.begin(), itEnd = groupNode.children.end();
-                    it != itEnd;
-                    ++it )
-                writeTestCase( **it );
-
-            xml.scopedElement( "system-out" ).writeText( trim( stdOutForSuite.str() ), false );
-            xml.scopedElement( "system-err" ).writeText( trim( stdErrForSuite.str() ), false );
+                xml.writeAttribute( "time", durationToString( suiteTime ) );
+        }
+
+        // Trimmed as trim() would, but a block at a time, holding back
+        // whitespace until it is known not to be trailing. A run of ']'s
+        // is held back as well, so a "]]>" split across blocks is still
+        // seen, and escaped, as one
+        void writeSuiteOutput( std::string const& elementName, TempFileStream const& output ) {
+            static char const* whitespaceChars = "\n\r\t ";
+            XmlWriter::ScopedElement e = xml.scopedElement( elementName );
+            std::string block, pending;
+            bool started = false;
+            std::size_t offset = 0;
+            while( output.readBlock( offset, block ) ) {
+                std::string::size_type start = 0;
+                if( !started ) {
+                    start = block.find_first_not_of( whitespaceChars );
+                    if( start == std::string::npos )
+                        continue;
+                    started = true;
+                }
+                pending.append( block, start, std::string::npos );
+                std::string::size_type end = pending.find_last_not_of( whitespaceChars );
+                if( end == std::string::npos )
+                    continue;
+                std::string::size_type held = end+1;
+                while( held > 0 && pending[held-1] == ']' )
+                    --held;
+                if( held > 0 ) {
+                    xml.writeText( pending.substr( 0, held ), false );
+                    pending.erase( 0, held );
+                }
+            }
+            std::string::size_type end = pending.find_last_not_of( whitespaceChars );
+            if( end != std::string::npos )
+                xml.writeText( pending.substr( 0, end+1 ), false );
         }
 
         void writeTestCase( TestCaseNode const& testCaseNode ) {
@@ -9448,6 +14510,8 @@ namespace Catch {
                 name = rootName + "/" + name;
 
             if( !sectionNode.assertions.empty() ||
+                sectionNode.directAssertions.total() > 0 ||
+                !sectionNode.benchmarks.empty() ||
                 !sectionNode.stdOut.empty() ||
                 !sectionNode.stdErr.empty() ) {
                 XmlWriter::ScopedElement e = xml.scopedElement( "testcase" );
@@ -9459,8 +14523,9 @@ namespace Catch {
                     xml.writeAttribute( "classname", className );
                     xml.writeAttribute( "name", name );
                 }
-                xml.writeAttribute( "time", Catch::toString( sectionNode.stats.durationInSeconds ) );
+                xml.writeAttribute( "time", durationToString( sectionNode.stats.durationInNanoseconds ) );
 
+                writeBenchmarks( sectionNode );
                 writeAssertions( sectionNode );
 
                 if( !sectionNode.stdOut.empty() )
@@ -9479,6 +14544,32 @@ namespace Catch {
                     writeSection( className, name, **it );
         }
 
+        // JUnit has nowhere to put timings other than the testcase's own, so
+        // benchmark results are written as testcase properties
+        void writeBenchmarks( SectionNode const& sectionNode ) {
+            if( sectionNode.benchmarks.empty() )
+                return;
+            XmlWriter::ScopedElement e = xml.scopedElement( "properties" );
+            for( SectionNode::Benchmarks::const_iterator
+                    it = sectionNode.benchmarks.begin(), itEnd = sectionNode.benchmarks.end();
+                    it != itEnd;
+                    ++it ) {
+                std::string prefix = "benchmark." + it->info.name + ".";
+                writeProperty( prefix + "mean_ns", it->mean );
+                writeProperty( prefix + "median_ns", it->median );
+                writeProperty( prefix + "stddev_ns", it->standardDeviation );
+                writeProperty( prefix + "samples", it->samples.size() );
+                writeProperty( prefix + "iterations", it->iterationsPerSample );
+                writeProperty( prefix + "outliers", it->outliers.total() );
+            }
+        }
+        template<typename T>
+        void writeProperty( std::string const& name, T const& value ) {
+            xml.scopedElement( "property" )
+                .writeAttribute( "name", name )
+                .writeAttribute( "value", value );
+        }
+
         void writeAssertions( SectionNode const& sectionNode ) {
             for( SectionNode::Assertions::const_iterator
                     it = sectionNode.assertions.begin(), itEnd = sectionNode.assertions.end();
@@ -9539,8 +14630,10 @@ namespace Catch {
 
         XmlWriter xml;
         Timer suiteTimer;
-        std::ostringstream stdOutForSuite;
-        std::ostringstream stdErrForSuite;
+        CATCH_AUTO_PTR( TempFileStream ) suite;
+        CATCH_AUTO_PTR( TempFileStream ) stdOutForSuite;
+        CATCH_AUTO_PTR( TempFileStream ) stdErrForSuite;
+        std::size_t suiteAttributesOffset;
         unsigned int unexpectedExceptions;
     };
 
@@ -9548,6 +14641,340 @@ namespace Catch {
 
 } // end namespace Catch
 
+// #included from: ../reporters/catch_reporter_eventlog.hpp
+#define TWOBLUECUBES_CATCH_REPORTER_EVENTLOG_HPP_INCLUDED
+
+namespace Catch {
+
+    // Writes every event out as it happens, in the compact binary form that
+    // --jobs workers send their parent, with file, class, tag and macro names
+    // only written the first time they come up. Run with --replay later to turn
+    // the log into any other report
+    class EventLogReporter : public EventStreamReporter {
+    public:
+        EventLogReporter( ReporterConfig const& _config )
+        :   EventStreamReporter( preferences(), &m_strings ),
+            m_stream( _config.stream() )
+        {
+            m_stream << eventLogHeader;
+        }
+
+        virtual ~EventLogReporter() CATCH_OVERRIDE;
+
+        static std::string getDescription() {
+            return "Writes a compact binary log of every event, for --replay to report on later";
+        }
+
+        virtual void noMatchingTestCases( std::string const& spec ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::NoMatchingTestCases );
+            event.writeString( spec );
+            send( event );
+        }
+        virtual void testRunStarting( TestRunInfo const& testRunInfo ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestRunStarting );
+            event.writeString( testRunInfo.name );
+            send( event );
+        }
+        virtual void testGroupStarting( GroupInfo const& groupInfo ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestGroupStarting );
+            event.writeString( groupInfo.name );
+            event.writeInt( groupInfo.groupIndex );
+            event.writeInt( groupInfo.groupsCounts );
+            send( event );
+        }
+        virtual void testCaseStarting( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::TestCaseStarting );
+            event.write( testInfo );
+            startTestCase( event );
+        }
+        virtual void testRunEnded( TestRunStats const& testRunStats ) CATCH_OVERRIDE {
+            EventStreamReporter::testRunEnded( testRunStats );
+            m_stream.flush();
+        }
+        virtual void skipTest( TestCaseInfo const& testInfo ) CATCH_OVERRIDE {
+            EventWriter event = newEvent( EventKind::SkipTest );
+            event.write( testInfo );
+            send( event );
+        }
+
+    private:
+        // The log is written before anyone knows whether it will be replayed
+        // with -s, so passing assertions are logged whether or not it was given
+        static ReporterPreferences preferences() {
+            ReporterPreferences prefs;
+            prefs.shouldReportAllAssertions = true;
+            return prefs;
+        }
+
+        virtual void writeFrame( std::string const& frame ) CATCH_OVERRIDE {
+            m_stream.write( frame.data(), static_cast<std::streamsize>( frame.size() ) );
+        }
+
+        EventStringTable m_strings;
+        std::ostream& m_stream;
+    };
+
+    INTERNAL_CATCH_REGISTER_REPORTER( "eventlog", EventLogReporter )
+
+} // end namespace Catch
+
+// #included from: ../reporters/catch_reporter_jsonl.hpp
+#define TWOBLUECUBES_CATCH_REPORTER_JSONL_HPP_INCLUDED
+
+namespace Catch {
+
+    // One JSON object per line, for log pipelines: a line for each failed
+    // assertion (each assertion with -s), each nested section and each test
+    // case as it ends, and one for the whole run. Timestamps are nanoseconds
+    // since the Unix epoch, and durations are in nanoseconds too. Lines are
+    // built up in a large buffer and written out a block at a time
+    struct JsonlReporter : StreamingReporterBase {
+        JsonlReporter( ReporterConfig const& _config )
+        :   StreamingReporterBase( _config )
+        {
+            // The tests' own output would break up the lines
+            m_reporterPrefs.shouldRedirectStdOut = true;
+            m_buffer.reserve( bufferSize + 4096 );
+        }
+
+        virtual ~JsonlReporter() CATCH_OVERRIDE;
+
+        static std::string getDescription() {
+            return "Reports each test case, section and failed assertion as a line of JSON";
+        }
+
+        virtual void assertionStarting( AssertionInfo const& ) CATCH_OVERRIDE {}
+
+        virtual bool assertionEnded( AssertionStats const& assertionStats ) CATCH_OVERRIDE {
+            AssertionResult const& result = assertionStats.assertionResult;
+            // Warnings are always reported, as by the console reporter
+            if( !m_config->includeSuccessfulResults() && result.isOk() && result.getResultType() != ResultWas::Warning )
+                return false;
+            startLine( "assertion" );
+            writeField( "testCase", currentTestCaseInfo->name );
+            writeSectionPath();
+            writeSourceInfo( result.getSourceInfo() );
+            writeField( "macro", result.getTestMacroName() );
+            writeField( "ok", result.isOk() );
+            writeField( "result", resultName( result.getResultType() ) );
+            if( result.hasExpression() ) {
+                writeField( "expression", result.getExpression() );
+                writeField( "expansion", result.getExpandedExpression() );
+            }
+            startField( "messages" );
+            m_buffer += '[';
+            bool first = true;
+            for( std::vector<MessageInfo>::const_iterator it = assertionStats.infoMessages.begin(), itEnd = assertionStats.infoMessages.end();
+                    it != itEnd;
+                    ++it ) {
+                if( !first )
+                    m_buffer += ',';
+                writeString( it->message );
+                first = false;
+            }
+            m_buffer += ']';
+            endLine();
+            return true;
+        }
+
+        virtual void benchmarkEnded( BenchmarkStats const& stats ) CATCH_OVERRIDE {
+            startLine( "benchmark" );
+            writeField( "testCase", currentTestCaseInfo->name );
+            writeField( "name", stats.info.name );
+            writeSourceInfo( stats.info.lineInfo );
+            writeField( "meanNs", static_cast<uint64_t>( stats.mean + 0.5 ) );
+            writeField( "medianNs", static_cast<uint64_t>( stats.median + 0.5 ) );
+            writeField( "stddevNs", static_cast<uint64_t>( stats.standardDeviation + 0.5 ) );
+            writeField( "samples", static_cast<uint64_t>( stats.samples.size() ) );
+            writeField( "iterations", stats.iterationsPerSample );
+            endLine();
+        }
+
+        // The outermost section is the test case itself, which gets its own line
+        virtual void sectionEnded( SectionStats const& sectionStats ) CATCH_OVERRIDE {
+            if( m_sectionStack.size() > 1 ) {
+                startLine( "section" );
+                writeField( "testCase", currentTestCaseInfo->name );
+                writeSectionPath();
+                writeSourceInfo( sectionStats.sectionInfo.lineInfo );
+                writeField( "durationNs", sectionStats.durationInNanoseconds );
+                writeCounts( sectionStats.assertions );
+                endLine();
+            }
+            StreamingReporterBase::sectionEnded( sectionStats );
+        }
+
+        virtual void testCaseEnded( TestCaseStats const& testCaseStats ) CATCH_OVERRIDE {
+            TestCaseInfo const& testInfo = testCaseStats.testInfo;
+            startLine( "testCase" );
+            writeField( "name", testInfo.name );
+            if( !testInfo.className.empty() )
+                writeField( "className", testInfo.className );
+            startField( "tags" );
+            m_buffer += '[';
+            for( std::set<std::string>::const_iterator it = testInfo.tags.begin(), itEnd = testInfo.tags.end();
+                    it != itEnd;
+                    ++it ) {
+                if( it != testInfo.tags.begin() )
+                    m_buffer += ',';
+                writeString( *it );
+            }
+            m_buffer += ']';
+            writeSourceInfo( testInfo.lineInfo );
+            writeField( "durationNs", testCaseStats.durationInNanoseconds );
+            writeCounts( testCaseStats.totals.assertions );
+            writeField( "ok", testCaseStats.totals.assertions.allOk() );
+            if( testCaseStats.aborting )
+                writeField( "aborting", true );
+            if( !testCaseStats.stdOut.empty() )
+                writeField( "stdout", testCaseStats.stdOut );
+            if( !testCaseStats.stdErr.empty() )
+                writeField( "stderr", testCaseStats.stdErr );
+            endLine();
+            StreamingReporterBase::testCaseEnded( testCaseStats );
+        }
+
+        virtual void testRunEnded( TestRunStats const& testRunStats ) CATCH_OVERRIDE {
+            startLine( "testRun" );
+            writeField( "name", testRunStats.runInfo.name );
+            writeCounts( testRunStats.totals.assertions );
+            writeField( "testCasesPassed", static_cast<uint64_t>( testRunStats.totals.testCases.passed ) );
+            writeField( "testCasesFailed", static_cast<uint64_t>( testRunStats.totals.testCases.failed ) );
+            writeField( "testCasesFailedButOk", static_cast<uint64_t>( testRunStats.totals.testCases.failedButOk ) );
+            if( testRunStats.aborting )
+                writeField( "aborting", true );
+            endLine();
+            writeBuffer();
+            stream.flush();
+            StreamingReporterBase::testRunEnded( testRunStats );
+        }
+
+    private:
+        static const std::size_t bufferSize = 64*1024;
+
+        static char const* resultName( ResultWas::OfType resultType ) {
+            switch( resultType ) {
+                case ResultWas::Ok: return "ok";
+                case ResultWas::Info: return "info";
+                case ResultWas::Warning: return "warning";
+                case ResultWas::ExpressionFailed: return "expressionFailed";
+                case ResultWas::ExplicitFailure: return "explicitFailure";
+                case ResultWas::ThrewException: return "threwException";
+                case ResultWas::DidntThrowException: return "didntThrowException";
+                case ResultWas::FatalErrorCondition: return "fatalErrorCondition";
+                default: return "unknown";
+            }
+        }
+
+        void startLine( char const* type ) {
+            m_buffer += "{\"type\":\"";
+            m_buffer += type;
+            m_buffer += '"';
+            writeField( "timestamp", getWallClockNanoseconds() );
+        }
+        void endLine() {
+            m_buffer += "}\n";
+            if( m_buffer.size() >= bufferSize )
+                writeBuffer();
+        }
+        void writeBuffer() {
+            stream.write( m_buffer.data(), static_cast<std::streamsize>( m_buffer.size() ) );
+            m_buffer.clear();
+        }
+
+        void startField( char const* name ) {
+            m_buffer += ",\"";
+            m_buffer += name;
+            m_buffer += "\":";
+        }
+        void writeField( char const* name, std::string const& value ) {
+            startField( name );
+            writeString( value );
+        }
+        void writeField( char const* name, char const* value ) {
+            startField( name );
+            writeString( value );
+        }
+        void writeField( char const* name, bool value ) {
+            startField( name );
+            m_buffer += value ? "true" : "false";
+        }
+        void writeField( char const* name, uint64_t value ) {
+            startField( name );
+            char digits[20];
+            char* end = digits + sizeof(digits);
+            char* p = end;
+            do {
+                *--p = static_cast<char>( '0' + value % 10 );
+                value /= 10;
+            } while( value != 0 );
+            m_buffer.append( p, end );
+        }
+
+        void writeCounts( Counts const& counts ) {
+            writeField( "passed", static_cast<uint64_t>( counts.passed ) );
+            writeField( "failed", static_cast<uint64_t>( counts.failed ) );
+            writeField( "failedButOk", static_cast<uint64_t>( counts.failedButOk ) );
+        }
+        void writeSourceInfo( SourceLineInfo const& lineInfo ) {
+            writeField( "file", lineInfo.file );
+            writeField( "line", static_cast<uint64_t>( lineInfo.line ) );
+        }
+        // Names of the enclosing sections, leaving out the test case's own
+        void writeSectionPath() {
+            startField( "sections" );
+            m_buffer += '[';
+            for( std::size_t i = 1; i < m_sectionStack.size(); ++i ) {
+                if( i > 1 )
+                    m_buffer += ',';
+                writeString( m_sectionStack[i].name );
+            }
+            m_buffer += ']';
+        }
+
+        // Copies runs of characters that need no escaping in one go
+        void writeString( char const* str, std::size_t size ) {
+            static char const hexDigits[] = "0123456789abcdef";
+            m_buffer += '"';
+            std::size_t runStart = 0;
+            for( std::size_t i = 0; i < size; ++i ) {
+                unsigned char c = static_cast<unsigned char>( str[i] );
+                if( c >= 0x20 && c != '"' && c != '\\' )
+                    continue;
+                m_buffer.append( str + runStart, i - runStart );
+                runStart = i + 1;
+                switch( c ) {
+                    case '"':  m_buffer += "\\\""; break;
+                    case '\\': m_buffer += "\\\\"; break;
+                    case '\n': m_buffer += "\\n"; break;
+                    case '\r': m_buffer += "\\r"; break;
+                    case '\t': m_buffer += "\\t"; break;
+                    case '\b': m_buffer += "\\b"; break;
+                    case '\f': m_buffer += "\\f"; break;
+                    default:
+                        m_buffer += "\\u00";
+                        m_buffer += hexDigits[c >> 4];
+                        m_buffer += hexDigits[c & 0xf];
+                        break;
+                }
+            }
+            m_buffer.append( str + runStart, size - runStart );
+            m_buffer += '"';
+        }
+        void writeString( std::string const& str ) {
+            writeString( str.data(), str.size() );
+        }
+        void writeString( char const* str ) {
+            writeString( str, std::strlen( str ) );
+        }
+
+        std::string m_buffer;
+    };
+
+    INTERNAL_CATCH_REGISTER_REPORTER( "jsonl", JsonlReporter )
+
+} // end namespace Catch
+
 // #included from: ../reporters/catch_reporter_console.hpp
 #define TWOBLUECUBES_CATCH_REPORTER_CONSOLE_HPP_INCLUDED
 
@@ -9591,6 +15018,34 @@ namespace Catch {
             return true;
         }
 
+        virtual void benchmarkEnded( BenchmarkStats const& _benchmarkStats ) CATCH_OVERRIDE {
+            lazyPrint();
+            {
+                Colour colourGuard( Colour::FileName );
+                stream << _benchmarkStats.info.lineInfo << ": ";
+            }
+            stream << "benchmark '" << _benchmarkStats.info.name << "'\n"
+                   << "  " << pluralise( _benchmarkStats.samples.size(), "sample" )
+                   << " of " << pluralise( static_cast<std::size_t>( _benchmarkStats.iterationsPerSample ), "iteration" ) << "\n";
+            {
+                Colour colourGuard( Colour::ReconstructedExpression );
+                stream << "  mean " << nanosecondsToString( _benchmarkStats.mean )
+                       << ", median " << nanosecondsToString( _benchmarkStats.median )
+                       << ", std dev " << nanosecondsToString( _benchmarkStats.standardDeviation ) << "\n";
+            }
+            stream << "  range " << nanosecondsToString( _benchmarkStats.min )
+                   << " to " << nanosecondsToString( _benchmarkStats.max ) << "\n";
+
+            OutlierClassification const& outliers = _benchmarkStats.outliers;
+            if( outliers.total() > 0 ) {
+                Colour colourGuard( Colour::Warning );
+                stream << "  found " << pluralise( outliers.total(), "outlier" )
+                       << " (" << outliers.lowSevere << " low severe, " << outliers.lowMild << " low mild, "
+                       << outliers.highMild << " high mild, " << outliers.highSevere << " high severe)\n";
+            }
+            stream << std::endl;
+        }
+
         virtual void sectionStarting( SectionInfo const& _sectionInfo ) CATCH_OVERRIDE {
             m_headerPrinted = false;
             StreamingReporterBase::sectionStarting( _sectionInfo );
@@ -9607,12 +15062,12 @@ namespace Catch {
             }
             if( m_headerPrinted ) {
                 if( m_config->showDurations() == ShowDurations::Always )
-                    stream << "Completed in " << _sectionStats.durationInSeconds << "s" << std::endl;
+                    stream << "Completed in " << durationToString( _sectionStats.durationInNanoseconds ) << "s" << std::endl;
                 m_headerPrinted = false;
             }
             else {
                 if( m_config->showDurations() == ShowDurations::Always )
-                    stream << _sectionStats.sectionInfo.name << " completed in " << _sectionStats.durationInSeconds << "s" << std::endl;
+                    stream << _sectionStats.sectionInfo.name << " completed in " << durationToString( _sectionStats.durationInNanoseconds ) << "s" << std::endl;
             }
             StreamingReporterBase::sectionEnded( _sectionStats );
         }
@@ -10029,6 +15484,16 @@ namespace Catch {
             return true;
         }
 
+        virtual void benchmarkEnded( BenchmarkStats const& _benchmarkStats ) {
+            stream << _benchmarkStats.info.lineInfo << ": benchmark '" << _benchmarkStats.info.name << "':"
+                   << " mean " << nanosecondsToString( _benchmarkStats.mean )
+                   << ", median " << nanosecondsToString( _benchmarkStats.median )
+                   << ", std dev " << nanosecondsToString( _benchmarkStats.standardDeviation )
+                   << " (" << pluralise( _benchmarkStats.samples.size(), "sample" )
+                   << " of " << pluralise( static_cast<std::size_t>( _benchmarkStats.iterationsPerSample ), "iteration" ) << ")"
+                   << std::endl;
+        }
+
         virtual void testRunEnded( TestRunStats const& _testRunStats ) {
             printTotals( _testRunStats.totals );
             stream << "\n" << std::endl;
@@ -10306,6 +15771,8 @@ namespace Catch {
     IConfig::~IConfig() {}
     XmlReporter::~XmlReporter() {}
     JunitReporter::~JunitReporter() {}
+    EventLogReporter::~EventLogReporter() {}
+    JsonlReporter::~JsonlReporter() {}
     TestRegistry::~TestRegistry() {}
     FreeFunctionTestCase::~FreeFunctionTestCase() {}
     IGeneratorInfo::~IGeneratorInfo() {}
@@ -10426,6 +15893,8 @@ int main (int argc, char * const argv[]) {
 #endif
 #define CATCH_ANON_TEST_CASE() INTERNAL_CATCH_TESTCASE( "", "" )
 
+#define CATCH_BENCHMARK( name ) INTERNAL_CATCH_BENCHMARK( name )
+
 #define CATCH_REGISTER_REPORTER( name, reporterType ) INTERNAL_CATCH_REGISTER_REPORTER( name, reporterType )
 #define CATCH_REGISTER_LEGACY_REPORTER( name, reporterType ) INTERNAL_CATCH_REGISTER_LEGACY_REPORTER( name, reporterType )
 
@@ -10495,6 +15964,8 @@ int main (int argc, char * const argv[]) {
 #endif
 #define ANON_TEST_CASE() INTERNAL_CATCH_TESTCASE( "", "" )
 
+#define BENCHMARK( name ) INTERNAL_CATCH_BENCHMARK( name )
+
 #define REGISTER_REPORTER( name, reporterType ) INTERNAL_CATCH_REGISTER_REPORTER( name, reporterType )
 #define REGISTER_LEGACY_REPORTER( name, reporterType ) INTERNAL_CATCH_REGISTER_LEGACY_REPORTER( name, reporterType )
 